@@ -3,75 +3,428 @@
 #include "Ext4.hpp"
 #include "SetAssociativeCache.hpp"
 #include "DirectMappedCache.hpp"
+#include "HardDisk.hpp"
+#include "SolidStateDrive.hpp"
+#include "TimedSimulation.hpp"
+#include "MetricsWriter.hpp"
+#include "ResultsWriter.hpp"
+#include "Experiment.hpp"
 #include <tabulate/table.hpp>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <string>
 
 using namespace std;
 
-int main() {
+int main(int argc, char* argv[]) {
 
     using namespace tabulate;
     using Row_t = Table::Row_t;
 
+    // --formato=tabla|json|csv|prometheus: tablas (por defecto) o resultados
+    //     legibles por maquina, sin construir ninguna tabla
+    // --salida=<fichero>: resultados a fichero en vez de a la salida estandar
+    // --series=<fichero>: vuelca las ventanas del calentamiento (CSV, o JSON
+    //     por lineas si la extension es .jsonl)
+    // --config=<fichero.ini>: ejecuta los barridos del fichero en vez de los
+    //     escenarios de demostracion (se puede repetir)
+    // --<clave>=<valores>: cualquier campo de ScenarioSpec (cache, capacity,
+    //     ways, filesystem, workload...), con listas y rangos; se aplica a
+    //     todos los barridos y, sin --config, forma uno propio. Con
+    //     --workload=secuencial|aleatorio no se usan blocks, theta, drift_*
+    //     ni seed
+    // --hilos=<n>: hilos para los barridos
+    ResultsFormat format = RESULTS_TABLE;
+    std::string output_path;
+    std::string series_path;
+    std::vector<std::string> config_paths;
+    std::vector<std::pair<std::string, std::string>> overrides;
+    long long threads = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        if (arg.rfind("--", 0) != 0 || equals == std::string::npos) {
+            cerr << "Opcion desconocida: " << arg << " (se esperaba --clave=valor)\n";
+            return 1;
+        }
+        std::string key = arg.substr(2, equals - 2);
+        std::string value = arg.substr(equals + 1);
+        if (key == "formato") {
+            if (!ResultsWriter::parse_format(value, format)) {
+                cerr << "Formato desconocido: " << value << " (tabla, json, csv o prometheus)\n";
+                return 1;
+            }
+        } else if (key == "salida") {
+            output_path = value;
+        } else if (key == "series") {
+            series_path = value;
+        } else if (key == "config") {
+            config_paths.push_back(value);
+        } else if (key == "hilos") {
+            threads = std::atoll(value.c_str());
+            if (threads < 1 || threads > 1024) {
+                cerr << "--hilos necesita un numero entre 1 y 1024\n";
+                return 1;
+            }
+        } else {
+            overrides.emplace_back(key, value);
+        }
+    }
+
+    std::ofstream output_file;
+    if (!output_path.empty()) {
+        output_file.open(output_path);
+        if (!output_file) {
+            cerr << "No se puede escribir " << output_path << "\n";
+            return 1;
+        }
+    }
+    std::ostream& output = output_path.empty() ? cout : output_file;
+    bool tables = format == RESULTS_TABLE;
+    ResultsWriter results(format, output);
+
+    if (!config_paths.empty() || !overrides.empty()) {
+        std::vector<ScenarioSweep> sweeps;
+        std::string error;
+        ConfigFile config;
+        for (const std::string& path : config_paths) {
+            ConfigFile file;
+            if (!file.load(path, error)) {
+                cerr << error << "\n";
+                return 1;
+            }
+            std::vector<ScenarioSweep> from_file;
+            if (!build_sweeps(file, overrides, from_file, error)) {
+                cerr << path << ": " << error << "\n";
+                return 1;
+            }
+            sweeps.insert(sweeps.end(), from_file.begin(), from_file.end());
+        }
+        if (config_paths.empty() && !build_sweeps(config, overrides, sweeps, error)) {
+            cerr << error << "\n";
+            return 1;
+        }
+        long long failed = run_sweeps(sweeps, static_cast<int>(threads), results, cerr);
+        results.finish();
+        return failed == 0 ? 0 : 1;
+    }
+
     const int CACHE_SIZE = 512;  // Bloques en caché
     const int BLOCK_SIZE = 4096; // 4KB
     const int NUM_OPS = 10000;
     const int ways = 4;
 
 
-    vector<int> seq_access = generate_access_pattern(NUM_OPS, true);
-    vector<int> rand_access = generate_access_pattern(NUM_OPS, false);
+    AccessPattern seq_access(NUM_OPS, true);
+    AccessPattern rand_access(NUM_OPS, false);
 
     DirectMappedCache dmCache_ext3(CACHE_SIZE);
     DirectMappedCache dmCache_ext4(CACHE_SIZE);
 
+    dmCache_ext3.enable_ghosts(true);
+    dmCache_ext4.enable_ghosts(true);
+
     Ext3 ext3_dm(dmCache_ext3, BLOCK_SIZE);
     Ext4 ext4_dm(dmCache_ext4, BLOCK_SIZE);
 
     SetAssociativeCache saCache_ext3(CACHE_SIZE, ways);
     SetAssociativeCache saCache_ext4(CACHE_SIZE, ways);
 
+    saCache_ext3.enable_ghosts(true);
+    saCache_ext4.enable_ghosts(true);
+
     Ext3 ext3_sa(saCache_ext3, BLOCK_SIZE);
     Ext4 ext4_sa(saCache_ext4, BLOCK_SIZE);
 
+    // Cola del disco con planificador deadline para los cuatro sistemas: los
+    // de cache directa escriben en un disco duro y los asociativos en un SSD
+    IOScheduler sched_ext3_dm, sched_ext4_dm, sched_ext3_sa, sched_ext4_sa;
+    HardDisk hdd_ext3, hdd_ext4;
+    SSDGeometry ssd_geometry;
+    ssd_geometry.blocks_per_die = 32;
+    SolidStateDrive ssd_ext3(ssd_geometry), ssd_ext4(ssd_geometry);
+    sched_ext3_dm.set_device(&hdd_ext3);
+    sched_ext4_dm.set_device(&hdd_ext4);
+    sched_ext3_sa.set_device(&ssd_ext3);
+    sched_ext4_sa.set_device(&ssd_ext4);
+    ext3_dm.set_io_scheduler(&sched_ext3_dm);
+    ext4_dm.set_io_scheduler(&sched_ext4_dm);
+    ext3_sa.set_io_scheduler(&sched_ext3_sa);
+    ext4_sa.set_io_scheduler(&sched_ext4_sa);
+
+    TraceRecorder recorder_ext3;
+    TraceRecorder recorder_ext4;
+
+    Ext3 ext3_opt(recorder_ext3, BLOCK_SIZE);
+    Ext4 ext4_opt(recorder_ext4, BLOCK_SIZE);
+
 
     Table t_main;
     Table sub_main1;
     Table sub_main2;
+    Table sub_main3;
+    Table sub_main4;
+    Table sub_main5;
     t_main.format().hide_border();
     Table sub_table1;
     Table sub_table2;
 
     AdvancedStats stats_ext3 = {}, stats_ext4 = {};
-    
+    AdvancedStats opt_ext3 = {}, opt_ext4 = {};
+
+    // Con tablas, la del par Ext3/Ext4 recien simulado; con otro formato, sus
+    // dos filas van al informe
+    auto report = [&](std::string& title, const char* scenario, const char* cache, int cache_ways, const char* device,
+                      const FileSystem& fs3, const FileSystem& fs4) {
+        if (tables) {
+            return print_stats_table(stats_ext3, stats_ext4, title, &opt_ext3, &opt_ext4);
+        }
+        RunDescription run;
+        run.scenario = scenario;
+        run.workload = scenario;
+        run.ops = NUM_OPS;
+        run.write_ratio = 0.2;
+        run.cache = cache;
+        run.capacity = CACHE_SIZE;
+        run.ways = cache_ways;
+        run.block_size = BLOCK_SIZE;
+        run.scheduler = "deadline";
+        run.device = device;
+        run.filesystem = "ext3";
+        run.journaling = fs3.journaling();
+        results.add(run, stats_ext3);
+        run.filesystem = "ext4";
+        run.journaling = fs4.journaling();
+        results.add(run, stats_ext4);
+        return Table();
+    };
+
+    // Cota optima del escenario, una fila por sistema de archivos
+    auto report_optimal = [&](const char* scenario) {
+        if (tables) {
+            return;
+        }
+        RunDescription run;
+        run.scenario = scenario;
+        run.workload = scenario;
+        run.ops = NUM_OPS;
+        run.write_ratio = 0.2;
+        run.cache = "belady";
+        run.capacity = CACHE_SIZE;
+        run.ways = CACHE_SIZE;
+        run.block_size = BLOCK_SIZE;
+        run.filesystem = "ext3";
+        run.journaling = ext3_opt.journaling();
+        results.add(run, opt_ext3);
+        run.filesystem = "ext4";
+        run.journaling = ext4_opt.journaling();
+        results.add(run, opt_ext4);
+    };
+
     t_main.add_row(Row_t{"=== Simulación con acceso secuencial ==="});
+    run_optimal(ext3_opt, recorder_ext3, seq_access, CACHE_SIZE, opt_ext3);
+    run_optimal(ext4_opt, recorder_ext4, seq_access, CACHE_SIZE, opt_ext4);
+    report_optimal("secuencial");
+
     run_simulation(ext3_dm, seq_access, stats_ext3);
     run_simulation(ext4_dm, seq_access, stats_ext4);
-    std::string name1 = "Con cache por correspondecia directa";
-    sub_table1 = print_stats_table(stats_ext3, stats_ext4, name1);
+    std::string name1 = "Con cache por correspondecia directa (HDD)";
+    sub_table1 = report(name1, "secuencial", "direct_mapped", 1, "hdd", ext3_dm, ext4_dm);
 
     run_simulation(ext3_sa, seq_access, stats_ext3);
     run_simulation(ext4_sa, seq_access, stats_ext4);
-    std::string name2 = "Con cache asociativa por conjutos";
-    sub_table2 = print_stats_table(stats_ext3, stats_ext4, name2);
+    std::string name2 = "Con cache asociativa por conjutos (SSD)";
+    sub_table2 = report(name2, "secuencial", "set_associative", ways, "ssd", ext3_sa, ext4_sa);
 
     sub_main1.add_row(Row_t{sub_table1, sub_table2});
     t_main.add_row(Row_t{sub_main1});
 
     t_main.add_row(Row_t{"=== Simulación con acceso aleatorio ==="});
+    run_optimal(ext3_opt, recorder_ext3, rand_access, CACHE_SIZE, opt_ext3);
+    run_optimal(ext4_opt, recorder_ext4, rand_access, CACHE_SIZE, opt_ext4);
+    report_optimal("aleatorio");
+
+    // Cada escenario empieza con las caches vacias
+    ext3_dm.reset();
+    ext4_dm.reset();
+    ext3_sa.reset();
+    ext4_sa.reset();
+
     run_simulation(ext3_dm, rand_access, stats_ext3);
     run_simulation(ext4_dm, rand_access, stats_ext4);
-    std::string name3 = "Con cache por correspondencia directa";
-    sub_table1 = print_stats_table(stats_ext3, stats_ext4, name3);
+    std::string name3 = "Con cache por correspondencia directa (HDD)";
+    sub_table1 = report(name3, "aleatorio", "direct_mapped", 1, "hdd", ext3_dm, ext4_dm);
     
     run_simulation(ext3_sa, rand_access, stats_ext3);
     run_simulation(ext4_sa, rand_access, stats_ext4);
-    std::string name4 = "Con cache asociativa por conjutos";
-    sub_table2 = print_stats_table(stats_ext3, stats_ext4, name4);
+    std::string name4 = "Con cache asociativa por conjutos (SSD)";
+    sub_table2 = report(name4, "aleatorio", "set_associative", ways, "ssd", ext3_sa, ext4_sa);
 
     sub_main2.add_row(Row_t{sub_table1, sub_table2});
     t_main.add_row(Row_t{sub_main2});
 
+    // Carga Zipf cuyo conjunto caliente se desplaza 64 bloques cada 1000 operaciones
+    PhaseSpec zipf_phase;
+    zipf_phase.ops = NUM_OPS;
+    zipf_phase.keys[0].distribution = ZIPF;
+    zipf_phase.keys[0].num_blocks = 1 << 12;
+    zipf_phase.keys[0].drift_every = 1000;
+    zipf_phase.keys[0].drift_step = 64;
+    Workload zipf_access(BLOCK_SIZE);
+    zipf_access.add_phase(zipf_phase);
+
+    t_main.add_row(Row_t{"=== Simulación con carga Zipf con deriva ==="});
+    run_optimal(ext3_opt, recorder_ext3, zipf_access, CACHE_SIZE, opt_ext3);
+    run_optimal(ext4_opt, recorder_ext4, zipf_access, CACHE_SIZE, opt_ext4);
+    report_optimal("zipf_deriva");
+
+    ext3_dm.reset();
+    ext4_dm.reset();
+    ext3_sa.reset();
+    ext4_sa.reset();
+
+    run_simulation(ext3_dm, zipf_access, stats_ext3);
+    run_simulation(ext4_dm, zipf_access, stats_ext4);
+    std::string name5 = "Con cache por correspondencia directa (HDD)";
+    sub_table1 = report(name5, "zipf_deriva", "direct_mapped", 1, "hdd", ext3_dm, ext4_dm);
+
+    run_simulation(ext3_sa, zipf_access, stats_ext3);
+    run_simulation(ext4_sa, zipf_access, stats_ext4);
+    std::string name6 = "Con cache asociativa por conjutos (SSD)";
+    sub_table2 = report(name6, "zipf_deriva", "set_associative", ways, "ssd", ext3_sa, ext4_sa);
+
+    sub_main3.add_row(Row_t{sub_table1, sub_table2});
+    t_main.add_row(Row_t{sub_main3});
+
+    // Dos inquilinos comparten la cache: el 0 con un conjunto caliente Zipf y
+    // el 1 con accesos aleatorios sobre un espacio grande (vecino ruidoso).
+    // Se comparan la cache compartida, un reparto de vias 3/1 y una cuota de
+    // 128 bloques para el inquilino 1, en tiempo simulado sobre disco duro.
+    PhaseSpec tenant_phase;
+    tenant_phase.ops = NUM_OPS;
+    tenant_phase.keys.resize(2);
+    tenant_phase.keys[0].distribution = ZIPF;
+    tenant_phase.keys[0].num_blocks = 1 << 10;
+    tenant_phase.keys[1].distribution = UNIFORM;
+    tenant_phase.keys[1].num_blocks = 1 << 14;
+    tenant_phase.keys[1].first_block = 1 << 16;
+    tenant_phase.keys[1].tenant = 1;
+    Workload tenant_access(BLOCK_SIZE);
+    tenant_access.add_phase(tenant_phase);
+
+    t_main.add_row(Row_t{"=== Simulación con dos inquilinos (acceso aleatorio ruidoso) ==="});
+    Row_t tenant_tables;
+    const char* partition_names[] = {"Cache compartida", "Reparto de vias 3/1", "Cuota de 128 bloques al inquilino 1"};
+    const char* partition_scenarios[] = {"inquilinos_compartida", "inquilinos_vias_3_1", "inquilinos_cuota_128"};
+    for (int config = 0; config < 3; ++config) {
+        SetAssociativeCache tenant_cache(CACHE_SIZE, ways);
+        if (config == 1) {
+            tenant_cache.set_way_partition(0, 3);
+            tenant_cache.set_way_partition(1, 1);
+        } else if (config == 2) {
+            tenant_cache.set_tenant_quota(1, 128);
+        }
+        Ext4 tenant_fs(tenant_cache, BLOCK_SIZE);
+        HardDisk tenant_disk;
+        TimedSimulation tenant_sim(tenant_fs, tenant_disk);
+        TenantStats tenants;
+        AdvancedStats tenant_stats = {};
+        tenant_sim.set_tenant_stats(&tenants);
+        tenant_sim.run(tenant_access, tenant_stats);
+
+        if (tables) {
+            std::string tenant_name = partition_names[config];
+            tenant_tables.push_back(print_tenant_table(tenants, tenant_name));
+            continue;
+        }
+        RunDescription run;
+        run.scenario = partition_scenarios[config];
+        run.workload = "zipf+uniform";
+        run.ops = NUM_OPS;
+        run.write_ratio = tenant_phase.write_ratio;
+        run.filesystem = "ext4";
+        run.cache = "set_associative";
+        run.capacity = CACHE_SIZE;
+        run.ways = ways;
+        run.block_size = BLOCK_SIZE;
+        run.journaling = tenant_fs.journaling();
+        run.device = "hdd";
+        results.add(run, tenant_stats);
+        for (int t = 0; t < tenants.tenants(); ++t) {
+            run.tenant = t;
+            results.add(run, tenants.of(t));
+        }
+    }
+    sub_main4.add_row(tenant_tables);
+    t_main.add_row(Row_t{sub_main4});
+
+    // Zipf estacionaria sobre caches frias: el calentamiento termina cuando la
+    // tasa de aciertos de 3 ventanas seguidas de 1000 operaciones varia menos
+    // de 3 puntos (o a mitad de la carga), y solo se mide lo posterior
+    PhaseSpec steady_phase;
+    steady_phase.ops = NUM_OPS;
+    steady_phase.keys[0].distribution = ZIPF;
+    steady_phase.keys[0].num_blocks = 1 << 12;
+    Workload steady_access(BLOCK_SIZE);
+    steady_access.add_phase(steady_phase);
+
+    t_main.add_row(Row_t{"=== Calentamiento hasta regimen estacionario (Zipf) ==="});
+    RunConfig warm_config;
+    warm_config.warmup.mode = WARMUP_STEADY_STATE;
+    warm_config.warmup.windows = 3;
+    warm_config.warmup.tolerance = 0.03;
+    warm_config.warmup.max_ops = NUM_OPS / 2;
+    warm_config.window_ops = 1000;
+    MetricsWriter series_writer(MetricsWriter::format_for(series_path));
+    if (!series_path.empty() && !series_writer.open(series_path)) {
+        cerr << "No se puede escribir " << series_path << "\n";
+    }
+    Row_t warm_tables;
+    for (int organization = 0; organization < 2; ++organization) {
+        DirectMappedCache warm_dm(CACHE_SIZE);
+        SetAssociativeCache warm_sa(CACHE_SIZE, ways);
+        Cache& warm_cache = organization == 0 ? static_cast<Cache&>(warm_dm) : static_cast<Cache&>(warm_sa);
+        Ext4 warm_fs(warm_cache, BLOCK_SIZE);
+        HardDisk warm_disk;
+        warm_fs.set_io_scheduler(&warm_disk);
+        TimeSeries series;
+        series.set_writer(&series_writer);
+        warm_config.series = &series;
+        std::string organization_name = organization == 0 ? "Ext4 con cache por correspondencia directa"
+                                                           : "Ext4 con cache asociativa por conjuntos";
+        series_writer.set_label(organization_name);
+        AdvancedStats warm_stats;
+        run_simulation(warm_fs, steady_access, warm_stats, warm_config);
+
+        if (tables) {
+            std::string warm_name = organization_name + " (calentamiento: " + std::to_string(warm_stats.warmup_ops) +
+                                    " ops, medida: " + hit_rate(warm_stats) + ")";
+            warm_tables.push_back(print_time_series_table(series, warm_name));
+            continue;
+        }
+        RunDescription run;
+        run.scenario = "calentamiento_zipf";
+        run.workload = "zipf";
+        run.ops = NUM_OPS;
+        run.write_ratio = steady_phase.write_ratio;
+        run.filesystem = "ext4";
+        run.cache = organization == 0 ? "direct_mapped" : "set_associative";
+        run.capacity = CACHE_SIZE;
+        run.ways = organization == 0 ? 1 : ways;
+        run.block_size = BLOCK_SIZE;
+        run.journaling = warm_fs.journaling();
+        run.device = "hdd";
+        results.add(run, warm_stats);
+    }
+    sub_main5.add_row(warm_tables);
+    t_main.add_row(Row_t{sub_main5});
+
+    if (!tables) {
+        results.finish();
+        return 0;
+    }
+
     t_main[0].format().font_align(FontAlign::center);
 
     t_main[1].format()
@@ -85,7 +438,28 @@ int main() {
         .font_align(FontAlign::center)
         .font_color(Color::green)
         .font_style({FontStyle::italic});
-    
-    cout << t_main << "\n";
+
+    t_main[4].format().font_align(FontAlign::center);
+
+    t_main[5].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::magenta)
+        .font_style({FontStyle::italic});
+
+    t_main[6].format().font_align(FontAlign::center);
+
+    t_main[7].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::cyan)
+        .font_style({FontStyle::italic});
+
+    t_main[8].format().font_align(FontAlign::center);
+
+    t_main[9].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::yellow)
+        .font_style({FontStyle::italic});
+
+    output << t_main << "\n";
     return 0;
 }
\ No newline at end of file
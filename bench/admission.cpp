@@ -0,0 +1,74 @@
+// Resistencia a recorridos secuenciales del filtro TinyLFU.
+// Un conjunto caliente de bloques se accede de forma repetida mientras un
+// recorrido secuencial (como generate_access_pattern(NUM_OPS, true)) pasa por
+// la cache. Se compara la tasa de aciertos con y sin filtro de admision, y el
+// coste de una comprobacion de admision.
+
+#include "DirectMappedCache.hpp"
+#include "SetAssociativeCache.hpp"
+#include "TinyLFU.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+const int CACHE_SIZE = 512;
+const int WAYS = 4;
+const int HOT_BLOCKS = 384;
+const int NUM_OPS = 1000000;
+
+// Cada 4 accesos: 3 al conjunto caliente (aleatorio) y 1 al recorrido
+template <typename C>
+double mixed_hit_rate(C& cache) {
+    std::mt19937 gen(10);
+    std::uniform_int_distribution<> hot(0, HOT_BLOCKS - 1);
+    AdvancedStats stats = {};
+    int scan = 1 << 20;
+    for (int i = 0; i < NUM_OPS; ++i) {
+        int block_id = (i & 3) == 3 ? scan++ : hot(gen);
+        if (!cache.access(block_id, stats)) {
+            cache.add_block(block_id);
+        }
+    }
+    return 100.0 * stats.cache_hits / (stats.cache_hits + stats.cache_misses);
+}
+
+}
+
+int main() {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "== " << HOT_BLOCKS << " bloques calientes + recorrido secuencial (25%), cache de "
+              << CACHE_SIZE << " bloques, % aciertos\n";
+
+    {
+        SetAssociativeCache lru(CACHE_SIZE, WAYS);
+        SetAssociativeCache filtered(CACHE_SIZE, WAYS);
+        TinyLFU filter(CACHE_SIZE);
+        filtered.set_admission_filter(&filter);
+        std::cout << "asociativa " << WAYS << " vias   LRU " << mixed_hit_rate(lru)
+                  << "   TinyLFU " << mixed_hit_rate(filtered) << "\n";
+    }
+    {
+        DirectMappedCache plain(CACHE_SIZE);
+        DirectMappedCache filtered(CACHE_SIZE);
+        TinyLFU filter(CACHE_SIZE);
+        filtered.set_admission_filter(&filter);
+        std::cout << "directa              sin filtro " << mixed_hit_rate(plain)
+                  << "   TinyLFU " << mixed_hit_rate(filtered) << "\n";
+    }
+
+    TinyLFU filter(CACHE_SIZE);
+    const int CHECKS = 20000000;
+    int admitted = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < CHECKS; ++i) {
+        filter.record(i & 4095);
+        admitted += filter.admit(i & 4095, (i * 7) & 4095);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << "\nrecord + admit: " << std::chrono::duration<double, std::nano>(end - start).count() / CHECKS
+              << " ns (" << admitted << " admitidos)\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+// Comparacion de organizaciones de cache sobre las mismas trazas de main.cpp
+// (acceso secuencial y aleatorio, Ext3 y Ext4): tasa de aciertos y lecturas de
+// disco para correspondencia directa, asociativa por conjuntos, sesgada, zcache
+// y totalmente asociativa.
+
+#include "DirectMappedCache.hpp"
+#include "Ext3.hpp"
+#include "Ext4.hpp"
+#include "FullyAssociativeCache.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Simulator.hpp"
+#include "SkewedAssociativeCache.hpp"
+#include "ZCache.hpp"
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int CACHE_SIZE = 512;
+const int BLOCK_SIZE = 4096;
+const int NUM_OPS = 10000;
+const int WAYS = 4;
+
+struct Organization {
+    std::string name;
+    std::function<std::unique_ptr<Cache>()> make;
+};
+
+void report(const std::string& fs_name, const AdvancedStats& stats, double ns) {
+    std::cout << "  " << fs_name << std::setw(8) << std::setprecision(2)
+              << 100.0 * stats.cache_hits / (stats.cache_hits + stats.cache_misses) << "%"
+              << std::setw(9) << stats.disk_reads
+              << std::setw(9) << std::setprecision(1) << ns;
+}
+
+}
+
+int main() {
+    std::vector<Organization> organizations = {
+        {"directa", []() { return std::unique_ptr<Cache>(new DirectMappedCache(CACHE_SIZE)); }},
+        {"asociativa 4 vias", []() { return std::unique_ptr<Cache>(new SetAssociativeCache(CACHE_SIZE, WAYS)); }},
+        {"sesgada 4 vias", []() { return std::unique_ptr<Cache>(new SkewedAssociativeCache(CACHE_SIZE, WAYS)); }},
+        {"zcache 4 vias L=2", []() { return std::unique_ptr<Cache>(new ZCache(CACHE_SIZE, WAYS, 2)); }},
+        {"zcache 4 vias L=3", []() { return std::unique_ptr<Cache>(new ZCache(CACHE_SIZE, WAYS, 3)); }},
+        {"totalmente asociativa", []() { return std::unique_ptr<Cache>(new FullyAssociativeCache(CACHE_SIZE)); }},
+    };
+
+    std::vector<int> seq_access = generate_access_pattern(NUM_OPS, true);
+    std::vector<int> rand_access = generate_access_pattern(NUM_OPS, false);
+
+    std::cout << std::fixed;
+    for (auto* trace : {&seq_access, &rand_access}) {
+        std::cout << "== " << (trace == &seq_access ? "Acceso secuencial" : "Acceso aleatorio")
+                  << " (aciertos, lecturas de disco, ns/acceso)\n";
+        for (const Organization& org : organizations) {
+            std::cout << std::setw(22) << std::left << org.name << std::right;
+            auto cache3 = org.make();
+            auto cache4 = org.make();
+            Ext3 ext3(*cache3, BLOCK_SIZE);
+            Ext4 ext4(*cache4, BLOCK_SIZE);
+            AdvancedStats stats = {};
+
+            auto start = std::chrono::steady_clock::now();
+            run_simulation(ext3, *trace, stats);
+            auto end = std::chrono::steady_clock::now();
+            report("Ext3", stats, std::chrono::duration<double, std::nano>(end - start).count() / trace->size());
+
+            start = std::chrono::steady_clock::now();
+            run_simulation(ext4, *trace, stats);
+            end = std::chrono::steady_clock::now();
+            report("  Ext4", stats, std::chrono::duration<double, std::nano>(end - start).count() / trace->size());
+            std::cout << "\n";
+        }
+    }
+    return 0;
+}
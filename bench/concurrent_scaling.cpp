@@ -0,0 +1,111 @@
+// Benchmark de escalado de las caches concurrentes de 1 a N hilos (N = argv[1]
+// o el numero de nucleos disponibles).
+// Cada hilo reproduce su propia secuencia de accesos (80% lecturas, 20%
+// escrituras) sobre un rango compartido de bloques y lleva sus propias
+// estadisticas; al final se reportan operaciones por segundo, tasa de aciertos
+// y, para ShardedCache, el tiempo medio de retencion de los locks.
+
+#include "AtomicDirectMappedCache.hpp"
+#include "ShardedCache.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int CACHE_SIZE = 1 << 16;
+const int WAYS = 8;
+const int STRIPES = 64;
+const int OPS_PER_THREAD = 2000000;
+const int BLOCK_RANGE = CACHE_SIZE * 2;
+
+void worker(Cache& cache, int seed, AdvancedStats& stats) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> block_dist(0, BLOCK_RANGE - 1);
+    std::uniform_int_distribution<> op_dist(0, 9);
+
+    for (int i = 0; i < OPS_PER_THREAD; ++i) {
+        int block_id = block_dist(gen);
+        if (!cache.access(block_id, stats)) {
+            cache.add_block(block_id);
+        }
+        if (op_dist(gen) < 2) {
+            cache.mark_dirty(block_id);
+        }
+    }
+}
+
+// Ejecuta la carga con el numero de hilos dado e imprime una fila de resultados
+void run(const std::string& name, Cache& cache, unsigned int threads, std::function<std::string()> lock_info) {
+    std::vector<AdvancedStats> stats(threads, AdvancedStats{});
+    std::vector<std::thread> pool;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int t = 0; t < threads; ++t) {
+        pool.emplace_back(worker, std::ref(cache), 1000 + t, std::ref(stats[t]));
+    }
+    for (auto& th : pool) {
+        th.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    long long hits = 0, misses = 0;
+    for (const auto& s : stats) {
+        hits += s.cache_hits;
+        misses += s.cache_misses;
+    }
+    double ops = static_cast<double>(threads) * OPS_PER_THREAD;
+
+    std::cout << std::setw(24) << std::left << name << std::right
+              << std::setw(8) << threads
+              << std::setw(16) << std::fixed << std::setprecision(0) << ops / seconds
+              << std::setw(11) << std::setprecision(2) << 100.0 * hits / (hits + misses) << "%"
+              << std::setw(18) << lock_info() << "\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    unsigned int max_threads = std::thread::hardware_concurrency();
+    if (argc > 1) {
+        max_threads = std::atoi(argv[1]);
+    }
+    if (max_threads == 0) {
+        max_threads = 4;
+    }
+
+    std::cout << CACHE_SIZE << " bloques, " << OPS_PER_THREAD << " ops/hilo\n";
+    std::cout << std::setw(24) << std::left << "cache" << std::right
+              << std::setw(8) << "hilos" << std::setw(16) << "ops/s"
+              << std::setw(12) << "aciertos" << std::setw(18) << "lock medio (ns)" << "\n";
+
+    // Potencias de dos por debajo de N y despues N
+    std::vector<unsigned int> thread_counts;
+    for (unsigned int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (unsigned int threads : thread_counts) {
+        ShardedCache sharded(CACHE_SIZE, WAYS, STRIPES, true);
+        run("ShardedCache(" + std::to_string(WAYS) + " vias)", sharded, threads, [&sharded]() {
+            ShardedCache::LockStats locks = sharded.lock_stats();
+            std::ostringstream out;
+            out << std::fixed << std::setprecision(1) << static_cast<double>(locks.hold_ns) / locks.acquisitions;
+            return out.str();
+        });
+
+        AtomicDirectMappedCache atomic_dm(CACHE_SIZE);
+        run("AtomicDirectMapped", atomic_dm, threads, []() { return std::string("-"); });
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Nucleo de la simulacion por sucesos: rendimiento de la cola de sucesos
+// (modelo "hold": sacar uno y reprogramarlo, con la cola a tamano constante)
+// y rendimiento simulado de Ext4 frente a la profundidad de cola en HDD y SSD,
+// sin planificador (orden de llegada) y con las politicas del IOScheduler.
+
+#include "DirectMappedCache.hpp"
+#include "EventQueue.hpp"
+#include "Ext4.hpp"
+#include "FastRandom.hpp"
+#include "HardDisk.hpp"
+#include "IOScheduler.hpp"
+#include "SolidStateDrive.hpp"
+#include "TimedSimulation.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const int HOLD_OPS = 20000000;
+const int NUM_OPS = 200000;
+
+double hold_mevents_per_s(size_t pending) {
+    EventQueue queue;
+    Xoshiro256pp gen(7);
+    queue.reserve(pending);
+    for (size_t i = 0; i < pending; ++i) {
+        queue.push(gen.uniform() * 10.0, 0, static_cast<uint32_t>(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Event ev = {};
+    for (int i = 0; i < HOLD_OPS; ++i) {
+        queue.pop(ev);
+        queue.push(ev.time + gen.uniform() * 10.0, ev.type, ev.data);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return HOLD_OPS / std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+// policy < 0: sin planificador
+template <typename Device>
+void depth_sweep(const char* name, int policy, const char* policy_name) {
+    std::cout << "\n== Ext4 + " << name << " (" << policy_name << "), acceso aleatorio, "
+              << NUM_OPS << " operaciones\n";
+    std::cout << "prof.  ops/s simuladas  latencia media (ms)  Msucesos/s reales\n";
+    for (int depth : {1, 2, 4, 8, 16, 32, 64}) {
+        DirectMappedCache cache(512);
+        Ext4 fs(cache, 4096);
+        Device device;
+        TimingConfig config;
+        config.queue_depth = depth;
+        TimedSimulation sim(fs, device, config);
+        SchedulerConfig sched_config;
+        sched_config.policy = static_cast<SchedulerPolicy>(policy < 0 ? 0 : policy);
+        IOScheduler scheduler(sched_config);
+        if (policy >= 0) {
+            sim.set_scheduler(&scheduler);
+        }
+        AdvancedStats stats = {};
+
+        auto start = std::chrono::steady_clock::now();
+        sim.run(AccessPattern(NUM_OPS, false), stats);
+        auto end = std::chrono::steady_clock::now();
+        // Un START implicito y un DONE por operacion; sin contar periodicos ni DEVICE_FREE
+        double events = 2.0 * stats.completed_ops;
+
+        std::cout << std::setw(5) << depth
+                  << std::setw(16) << std::setprecision(0) << stats.completed_ops / (stats.simulated_time / 1000.0)
+                  << std::setw(21) << std::setprecision(3) << stats.op_latency / stats.completed_ops
+                  << std::setw(19) << std::setprecision(2)
+                  << events / std::chrono::duration<double, std::micro>(end - start).count() << "\n";
+    }
+}
+
+}
+
+int main() {
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "== Cola de sucesos (hold), Msucesos/s\n";
+    for (size_t pending : {16, 1024, 65536}) {
+        std::cout << "pendientes " << std::setw(6) << pending << "   " << hold_mevents_per_s(pending) << "\n";
+    }
+
+    depth_sweep<HardDisk>("HDD", -1, "orden de llegada");
+    depth_sweep<HardDisk>("HDD", NOOP, "noop");
+    depth_sweep<HardDisk>("HDD", DEADLINE, "deadline");
+    depth_sweep<HardDisk>("HDD", BFQ_LITE, "bfq_lite");
+    depth_sweep<SolidStateDrive>("SSD", -1, "orden de llegada");
+    depth_sweep<SolidStateDrive>("SSD", DEADLINE, "deadline");
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Microbenchmarks de las operaciones de cache y de los caminos de lectura y
+// escritura de los sistemas de archivos, con ns/op y reservas de memoria por
+// operacion (contadas sustituyendo operator new en este ejecutable).
+//
+// Cada caso se mide sobre una traza de bloques precalculada, para no medir el
+// generador, con tres mezclas relativas a la capacidad C:
+//   aciertos  uniforme sobre C/2 bloques ya cargados (casi todo aciertos)
+//   fallos    uniforme sobre 64 C bloques (casi todo fallos)
+//   mixta     Zipf(0.99) sobre 8 C bloques
+// El numero de repeticiones se calibra para que cada muestra dure al menos
+// MIN_SAMPLE_MS y se informa la mejor de SAMPLES muestras.
+
+#include "DirectMappedCache.hpp"
+#include "Ext3.hpp"
+#include "Ext4.hpp"
+#include "FastRandom.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Workload.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+long long allocations = 0;
+
+}
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    allocations++;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+const int BLOCK_SIZE = 4096;
+const int TRACE_LENGTH = 1 << 16;
+const int SAMPLES = 3;
+const double MIN_SAMPLE_MS = 10.0;
+
+enum Mix { HITS, MISSES, MIXED };
+const char* MIX_NAMES[] = {"aciertos", "fallos", "mixta"};
+
+// `max_blocks` acota el espacio para que los desplazamientos en bytes de los
+// sistemas de archivos quepan en un int
+std::vector<int> make_trace(Mix mix, int capacity, int max_blocks = 1 << 30) {
+    Xoshiro256pp gen(7);
+    std::vector<int> trace(TRACE_LENGTH);
+    long long span = mix == HITS ? capacity / 2 : mix == MISSES ? 64LL * capacity : 8LL * capacity;
+    span = span < max_blocks ? span : max_blocks;
+    ZipfGenerator zipf(static_cast<int>(span), 0.99);
+    for (int& block : trace) {
+        block = mix == MIXED ? zipf.next(gen.uniform()) : static_cast<int>(gen.bounded(static_cast<uint32_t>(span)));
+    }
+    return trace;
+}
+
+struct Result {
+    double ns_per_op;
+    double allocs_per_op;
+};
+
+// `body(i)` hace la operacion numero i; se repite sobre la traza hasta llenar la muestra
+template <typename Body>
+Result measure(Body&& body) {
+    long long ops = TRACE_LENGTH;
+    for (;;) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < ops; ++i) {
+            body(i & (TRACE_LENGTH - 1));
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (ms >= MIN_SAMPLE_MS) {
+            break;
+        }
+        ops *= 2;
+    }
+    Result best = {1e300, 0.0};
+    for (int s = 0; s < SAMPLES; ++s) {
+        long long allocated = allocations;
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < ops; ++i) {
+            body(i & (TRACE_LENGTH - 1));
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (ns / ops < best.ns_per_op) {
+            best = {ns / ops, static_cast<double>(allocations - allocated) / ops};
+        }
+    }
+    return best;
+}
+
+void report(const std::string& name, Result r) {
+    std::cout << "  " << std::setw(54) << std::left << name << std::right << std::setw(9) << std::setprecision(1)
+              << r.ns_per_op << std::setw(9) << std::setprecision(3) << r.allocs_per_op << "\n";
+}
+
+// Carga los bloques de la traza de aciertos para que esten en la cache
+void prefill(Cache& cache, const std::vector<int>& trace) {
+    for (int block : trace) {
+        cache.add_block(block);
+    }
+}
+
+template <typename MakeCache>
+void bench_cache(const std::string& name, int capacity, MakeCache make) {
+    AdvancedStats stats = {};
+    for (Mix mix : {HITS, MISSES, MIXED}) {
+        std::vector<int> trace = make_trace(mix, capacity);
+        std::string label = name + " C=" + std::to_string(capacity) + " " + MIX_NAMES[mix];
+        auto cache = make();
+        prefill(*cache, make_trace(HITS, capacity));
+
+        // access sola (el estado solo cambia por el orden LRU) y el camino
+        // completo del sistema de archivos: access y add_block si falla
+        report(label + " access", measure([&](long long i) { cache->access(trace[i], stats); }));
+        report(label + " access+add_block", measure([&](long long i) {
+            if (!cache->access(trace[i], stats)) {
+                cache->add_block(trace[i]);
+            }
+        }));
+        report(label + " mark_dirty", measure([&](long long i) { cache->mark_dirty(trace[i]); }));
+    }
+}
+
+template <typename FS>
+void bench_filesystem(const std::string& name, int capacity) {
+    // Desplazamientos en bytes de hasta 2^31: como mucho 2^19 bloques de 4KB
+    const int MAX_BLOCKS = 1 << 19;
+    AdvancedStats stats = {};
+    for (Mix mix : {HITS, MISSES, MIXED}) {
+        std::vector<int> trace = make_trace(mix, capacity, MAX_BLOCKS);
+        std::string label = name + " C=" + std::to_string(capacity) + " " + MIX_NAMES[mix];
+        SetAssociativeCache cache(capacity, 8);
+        FS fs(cache, BLOCK_SIZE);
+        prefill(cache, make_trace(HITS, capacity));
+        report(label + " read", measure([&](long long i) { fs.read(trace[i] * BLOCK_SIZE, BLOCK_SIZE, stats); }));
+        report(label + " write", measure([&](long long i) { fs.write(trace[i] * BLOCK_SIZE, BLOCK_SIZE, stats); }));
+    }
+}
+
+}
+
+int main() {
+    std::cout << std::fixed;
+    std::cout << "== Operaciones de cache (ns/op, reservas/op)\n";
+    for (int capacity : {1 << 12, 1 << 20}) {
+        bench_cache("directa", capacity, [&]() { return std::make_unique<DirectMappedCache>(capacity); });
+        for (int ways : {2, 4, 8, 16}) {
+            bench_cache("asociativa " + std::to_string(ways) + " vias", capacity,
+                        [&]() { return std::make_unique<SetAssociativeCache>(capacity, ways); });
+        }
+    }
+
+    std::cout << "== Sistemas de archivos, cache asociativa de 8 vias (ns/op, reservas/op)\n";
+    for (int capacity : {1 << 12, 1 << 15}) {
+        bench_filesystem<Ext3>("Ext3", capacity);
+        bench_filesystem<Ext4>("Ext4", capacity);
+    }
+    return 0;
+}
@@ -0,0 +1,338 @@
+// Regresiones de rendimiento: ejecuta los escenarios principales de main
+// (secuencial/aleatorio x cache directa/asociativa x Ext3/Ext4, con la misma
+// cola y dispositivos) y mide accesos simulados por segundo.
+//
+// Cada escenario se repite --repeticiones veces, intercalando los escenarios
+// para que una deriva de la maquina no caiga sobre uno solo, y se informa la
+// media con su intervalo de confianza del 95% (t de Student).
+//   --base=<fichero.json>  compara con la linea base guardada: un escenario
+//       retrocede si la prueba t de Welch (una cola, 5%) es significativa y la
+//       caida supera MIN_CHANGE; en ese caso se sale con 1. La prueba necesita
+//       al menos 2 repeticiones en la medida y en la linea base: con menos
+//       se rechaza la ejecucion en vez de informar "Sin regresiones"
+//   --guardar              escribe la linea base en --base en vez de comparar
+//   --ops=<n>              operaciones por ejecucion (make regresion usa 10^8)
+//
+// Sin opciones (make bench) solo mide, con pocas operaciones.
+
+#include "DirectMappedCache.hpp"
+#include "Ext3.hpp"
+#include "Ext4.hpp"
+#include "HardDisk.hpp"
+#include "IOScheduler.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Simulator.hpp"
+#include "SolidStateDrive.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int CACHE_SIZE = 512;
+const int BLOCK_SIZE = 4096;
+const int WAYS = 4;
+const double MIN_CHANGE = 0.02;  // Cambios relativos menores no se señalan aunque sean significativos
+
+struct Scenario {
+    std::string name;
+    bool sequential;
+    bool set_associative;  // Con SSD; la directa escribe en un disco duro
+    bool ext4;
+};
+
+struct Summary {
+    std::string name;
+    std::vector<double> samples;  // Accesos por segundo
+    double mean = 0.0;
+    double stddev = 0.0;
+};
+
+// Cuantiles de la t de Student para 1..30 grados de libertad; a partir de ahi
+// los de la normal
+const double T_975[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                        2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                        2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+const double T_95[] = {6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833, 1.812,
+                       1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734, 1.729, 1.725,
+                       1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703, 1.701, 1.699, 1.697};
+
+// Grados de libertad fraccionarios (Welch) se redondean hacia abajo, que es
+// lo conservador
+double t_quantile(const double* table, double normal, double df) {
+    int index = static_cast<int>(df);
+    if (index < 1) {
+        index = 1;
+    }
+    return index > 30 ? normal : table[index - 1];
+}
+
+void summarize(Summary& s) {
+    double n = static_cast<double>(s.samples.size());
+    s.mean = 0.0;
+    for (double x : s.samples) {
+        s.mean += x;
+    }
+    s.mean /= n;
+    double squares = 0.0;
+    for (double x : s.samples) {
+        squares += (x - s.mean) * (x - s.mean);
+    }
+    s.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+}
+
+// Semiamplitud del intervalo de confianza del 95% de la media
+double half_interval(const Summary& s) {
+    double n = static_cast<double>(s.samples.size());
+    return n > 1 ? t_quantile(T_975, 1.960, n - 1) * s.stddev / std::sqrt(n) : 0.0;
+}
+
+// Estadistico t de Welch para media(base) > media(actual) y su cuantil critico
+// de una cola al 5%; true si la diferencia es significativa
+bool welch_significant(const Summary& base, const Summary& current, double& t) {
+    double nb = static_cast<double>(base.samples.size());
+    double nc = static_cast<double>(current.samples.size());
+    if (nb < 2 || nc < 2) {
+        t = 0.0;
+        return false;
+    }
+    double vb = base.stddev * base.stddev / nb;
+    double vc = current.stddev * current.stddev / nc;
+    double diff = base.mean - current.mean;
+    if (vb + vc == 0.0) {
+        t = diff > 0 ? INFINITY : diff < 0 ? -INFINITY : 0.0;
+        return diff > 0;
+    }
+    t = diff / std::sqrt(vb + vc);
+    double df = (vb + vc) * (vb + vc) / (vb * vb / (nb - 1) + vc * vc / (nc - 1));
+    return t > t_quantile(T_95, 1.645, df);
+}
+
+double run_once(const Scenario& scenario, long long ops) {
+    DirectMappedCache dm(CACHE_SIZE);
+    SetAssociativeCache sa(CACHE_SIZE, WAYS);
+    dm.enable_ghosts(true);
+    sa.enable_ghosts(true);
+    Cache& cache = scenario.set_associative ? static_cast<Cache&>(sa) : static_cast<Cache&>(dm);
+
+    IOScheduler scheduler;
+    HardDisk hdd;
+    SSDGeometry geometry;
+    geometry.blocks_per_die = 32;
+    SolidStateDrive ssd(geometry);
+    scheduler.set_device(scenario.set_associative ? static_cast<RequestSink*>(&ssd) : &hdd);
+
+    std::unique_ptr<FileSystem> fs;
+    if (scenario.ext4) {
+        fs = std::make_unique<Ext4>(cache, BLOCK_SIZE);
+    } else {
+        fs = std::make_unique<Ext3>(cache, BLOCK_SIZE);
+    }
+    fs->set_io_scheduler(&scheduler);
+
+    AccessPattern pattern(ops, scenario.sequential);
+    AdvancedStats stats = {};
+    auto start = std::chrono::steady_clock::now();
+    run_simulation(*fs, pattern, stats);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(ops) / seconds;
+}
+
+bool save_baseline(const std::string& path, long long ops, const std::vector<Summary>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << std::setprecision(17);
+    out << "{\n  \"ops\": " << ops << ",\n  \"escenarios\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Summary& s = results[i];
+        out << "    {\"nombre\": \"" << s.name << "\", \"media\": " << s.mean << ", \"desviacion\": " << s.stddev
+            << ", \"ic95\": " << half_interval(s) << ", \"muestras\": [";
+        for (size_t j = 0; j < s.samples.size(); ++j) {
+            out << (j ? ", " : "") << s.samples[j];
+        }
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Lee solo lo que escribe save_baseline: "ops" y, por escenario, "nombre" y
+// "muestras" (media y desviacion se recalculan)
+bool load_baseline(const std::string& path, long long& ops, std::vector<Summary>& results) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    size_t pos = text.find("\"ops\":");
+    if (pos == std::string::npos) {
+        return false;
+    }
+    ops = std::atoll(text.c_str() + pos + 6);
+    while ((pos = text.find("\"nombre\": \"", pos)) != std::string::npos) {
+        pos += 11;
+        size_t end = text.find('"', pos);
+        size_t open = text.find("\"muestras\": [", end);
+        size_t close = text.find(']', open);
+        if (end == std::string::npos || open == std::string::npos || close == std::string::npos) {
+            return false;
+        }
+        Summary s;
+        s.name = text.substr(pos, end - pos);
+        const char* cursor = text.c_str() + open + 13;
+        const char* stop = text.c_str() + close;
+        while (cursor < stop) {
+            char* next = nullptr;
+            double value = std::strtod(cursor, &next);
+            if (next == cursor) {
+                break;
+            }
+            s.samples.push_back(value);
+            cursor = next;
+            while (cursor < stop && (*cursor == ',' || *cursor == ' ')) {
+                ++cursor;
+            }
+        }
+        if (s.samples.empty()) {
+            return false;
+        }
+        summarize(s);
+        results.push_back(s);
+        pos = close;
+    }
+    return !results.empty();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    long long ops = 1000000;
+    long long repetitions = 3;
+    std::string baseline_path;
+    bool save = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t equals = arg.find('=');
+        std::string key = arg.substr(0, equals);
+        std::string value = equals == std::string::npos ? "" : arg.substr(equals + 1);
+        if (key == "--ops") {
+            ops = std::atoll(value.c_str());
+        } else if (key == "--repeticiones") {
+            repetitions = std::atoll(value.c_str());
+        } else if (key == "--base") {
+            baseline_path = value;
+        } else if (arg == "--guardar") {
+            save = true;
+        } else {
+            std::cerr << "Opcion desconocida: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (ops < 1 || repetitions < 1 || (save && baseline_path.empty())) {
+        std::cerr << "Se necesitan --ops y --repeticiones positivos, y --base para --guardar\n";
+        return 1;
+    }
+    if (!baseline_path.empty() && repetitions < 2) {
+        std::cerr << "Con --base se necesitan al menos 2 repeticiones para la prueba t\n";
+        return 1;
+    }
+
+    std::vector<Scenario> scenarios;
+    for (bool sequential : {true, false}) {
+        for (bool set_associative : {false, true}) {
+            for (bool ext4 : {false, true}) {
+                std::string name = std::string(sequential ? "secuencial" : "aleatorio") + "/" +
+                                   (set_associative ? "asociativa" : "directa") + "/" + (ext4 ? "Ext4" : "Ext3");
+                scenarios.push_back({name, sequential, set_associative, ext4});
+            }
+        }
+    }
+
+    std::vector<Summary> results(scenarios.size());
+    for (size_t i = 0; i < scenarios.size(); ++i) {
+        results[i].name = scenarios[i].name;
+    }
+    for (long long r = 0; r < repetitions; ++r) {
+        for (size_t i = 0; i < scenarios.size(); ++i) {
+            results[i].samples.push_back(run_once(scenarios[i], ops));
+        }
+    }
+    for (Summary& s : results) {
+        summarize(s);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "== Escenarios de main, " << ops << " operaciones x " << repetitions
+              << " repeticiones (millones de accesos/s, media +- IC 95%)\n";
+    for (const Summary& s : results) {
+        std::cout << "  " << std::setw(28) << std::left << s.name << std::right << std::setw(9) << s.mean / 1e6
+                  << " +- " << std::setw(6) << half_interval(s) / 1e6 << "\n";
+    }
+
+    if (baseline_path.empty()) {
+        return 0;
+    }
+    if (save) {
+        if (!save_baseline(baseline_path, ops, results)) {
+            std::cerr << "No se puede escribir " << baseline_path << "\n";
+            return 1;
+        }
+        std::cout << "Linea base guardada en " << baseline_path << "\n";
+        return 0;
+    }
+
+    long long baseline_ops = 0;
+    std::vector<Summary> baseline;
+    if (!load_baseline(baseline_path, baseline_ops, baseline)) {
+        std::cerr << "No se puede leer la linea base " << baseline_path << "\n";
+        return 1;
+    }
+    for (const Summary& b : baseline) {
+        if (b.samples.size() < 2) {
+            std::cerr << "La linea base " << baseline_path << " tiene menos de 2 muestras en " << b.name
+                      << "; guardala de nuevo con --repeticiones >= 2\n";
+            return 1;
+        }
+    }
+    if (baseline_ops != ops) {
+        std::cout << "Aviso: la linea base se midio con " << baseline_ops << " operaciones\n";
+    }
+
+    int regressions = 0;
+    std::cout << "== Comparacion con " << baseline_path << " (cambio relativo, t de Welch)\n";
+    for (const Summary& s : results) {
+        const Summary* base = nullptr;
+        for (const Summary& b : baseline) {
+            if (b.name == s.name) {
+                base = &b;
+            }
+        }
+        if (!base) {
+            std::cout << "  " << std::setw(28) << std::left << s.name << std::right << "  sin linea base\n";
+            continue;
+        }
+        double change = (s.mean - base->mean) / base->mean;
+        double t = 0.0;
+        bool slower = welch_significant(*base, s, t) && -change > MIN_CHANGE;
+        double t_faster = 0.0;
+        bool faster = welch_significant(s, *base, t_faster) && change > MIN_CHANGE;
+        regressions += slower;
+        std::cout << "  " << std::setw(28) << std::left << s.name << std::right << std::showpos << std::setw(8)
+                  << change * 100 << "%" << std::setw(9) << -t << std::noshowpos
+                  << (slower ? "  REGRESION" : faster ? "  mejora" : "") << "\n";
+    }
+    std::cout << (regressions ? std::to_string(regressions) + " escenarios con regresion\n" : "Sin regresiones\n");
+    return regressions ? 1 : 0;
+}
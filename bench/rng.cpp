@@ -0,0 +1,94 @@
+// Coste de generar direcciones y tipos de operacion para la carga sintetica:
+// std::mt19937 + distribuciones de <random> (lo que usaba el simulador) frente
+// a xoshiro256++ escalar con el rango de Lemire y el relleno por bloques.
+
+#include "AccessPattern.hpp"
+#include "FastRandom.hpp"
+#include "Simulator.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const int N = 50000000;
+const uint32_t RANGE = (1 << 24) + 1;
+
+template <typename F>
+double ns_per_value(F body) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t sink = body();
+    auto end = std::chrono::steady_clock::now();
+    volatile uint64_t keep = sink;
+    (void)keep;
+    return std::chrono::duration<double, std::nano>(end - start).count() / N;
+}
+
+}
+
+int main() {
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "== Direcciones uniformes en [0, 2^24], ns/valor\n";
+
+    std::cout << "mt19937 + uniform_int_distribution  " << ns_per_value([]() {
+        std::mt19937 gen(10);
+        std::uniform_int_distribution<> dist(0, 1 << 24);
+        uint64_t acc = 0;
+        for (int i = 0; i < N; ++i) {
+            acc += dist(gen);
+        }
+        return acc;
+    }) << "\n";
+
+    std::cout << "xoshiro256++ bounded (escalar)      " << ns_per_value([]() {
+        Xoshiro256pp gen(10);
+        uint64_t acc = 0;
+        for (int i = 0; i < N; ++i) {
+            acc += gen.bounded(RANGE);
+        }
+        return acc;
+    }) << "\n";
+
+    std::cout << "XoshiroBatch fill_bounded           " << ns_per_value([]() {
+        XoshiroBatch gen(10);
+        std::vector<uint32_t> buffer(4096);
+        uint64_t acc = 0;
+        for (int i = 0; i < N; i += 4096) {
+            gen.fill_bounded(buffer.data(), buffer.size(), RANGE);
+            acc += buffer[i & 4095];
+        }
+        return acc;
+    }) << "\n";
+
+    std::cout << "AccessPattern (aleatorio)           " << ns_per_value([]() {
+        uint64_t acc = 0;
+        for (int address : AccessPattern(N, false)) {
+            acc += address;
+        }
+        return acc;
+    }) << "\n";
+
+    std::cout << "\n== Lectura/escritura (20% escrituras), ns/decision\n";
+
+    std::cout << "mt19937 + uniform_int_distribution  " << ns_per_value([]() {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<> dist(0, 9);
+        uint64_t writes = 0;
+        for (int i = 0; i < N; ++i) {
+            writes += dist(gen) < 2;
+        }
+        return writes;
+    }) << "\n";
+
+    std::cout << "OperationMix                        " << ns_per_value([]() {
+        OperationMix mix(0.2);
+        uint64_t writes = 0;
+        for (int i = 0; i < N; ++i) {
+            writes += mix.next_is_write();
+        }
+        return writes;
+    }) << "\n";
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Benchmark de la funcion de correspondencia (SetIndexer).
+//  1. Coste aislado de calcular (conjunto, tag): division entera vs
+//     mascara (potencia de dos) vs reduccion de Lemire.
+//  2. Escenario secuencial de main.cpp con ambas caches, capacidad potencia de
+//     dos, sin potencia de dos y con XOR_HASH.
+//  3. Tasa de aciertos en un patron con paso igual al numero de conjuntos,
+//     donde el hashing XOR elimina los fallos por conflicto.
+
+#include "DirectMappedCache.hpp"
+#include "Ext3.hpp"
+#include "Ext4.hpp"
+#include "SetAssociativeCache.hpp"
+#include "SetIndex.hpp"
+#include "Simulator.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+const int BLOCK_SIZE = 4096;
+const int NUM_OPS = 500000;
+const int REPETITIONS = 5;
+const int INDEX_OPS = 100000000;
+
+double ns_per_index_division(uint32_t sets) {
+    volatile uint32_t divisor = sets;  // Impedir que el compilador lo convierta en constante
+    uint32_t acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < INDEX_OPS; ++i) {
+        uint32_t x = static_cast<uint32_t>(i) * 2654435761u;
+        acc += x % divisor + x / divisor;
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile uint32_t sink = acc;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / INDEX_OPS;
+}
+
+double ns_per_index_indexer(uint32_t sets) {
+    SetIndexer indexer(sets);
+    uint32_t acc = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < INDEX_OPS; ++i) {
+        int x = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+        acc += indexer.index(x) + indexer.tag(x);
+    }
+    auto end = std::chrono::steady_clock::now();
+    volatile uint32_t sink = acc;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(end - start).count() / INDEX_OPS;
+}
+
+// Tiempo medio (ns) por acceso del escenario secuencial con Ext3 y Ext4
+template <typename MakeCache>
+double sequential_ns(MakeCache make_cache, std::vector<int>& addresses) {
+    double best = 1e300;
+    for (int r = 0; r < REPETITIONS; ++r) {
+        auto cache3 = make_cache();
+        auto cache4 = make_cache();
+        Ext3 ext3(cache3, BLOCK_SIZE);
+        Ext4 ext4(cache4, BLOCK_SIZE);
+        AdvancedStats stats = {};
+        auto start = std::chrono::steady_clock::now();
+        run_simulation(ext3, addresses, stats);
+        run_simulation(ext4, addresses, stats);
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / (2.0 * addresses.size());
+        best = ns < best ? ns : best;
+    }
+    return best;
+}
+
+template <typename C>
+double strided_hit_rate(C cache, int stride) {
+    AdvancedStats stats = {};
+    for (int round = 0; round < 100; ++round) {
+        for (int i = 0; i < 64; ++i) {
+            int block_id = i * stride;
+            if (!cache.access(block_id, stats)) {
+                cache.add_block(block_id);
+            }
+        }
+    }
+    return 100.0 * stats.cache_hits / (stats.cache_hits + stats.cache_misses);
+}
+
+}
+
+int main() {
+    std::cout << std::fixed << std::setprecision(2);
+
+    std::cout << "== Calculo de (conjunto, tag), ns/op\n";
+    std::cout << std::setw(10) << "conjuntos" << std::setw(14) << "div/mod" << std::setw(14) << "SetIndexer" << "\n";
+    for (uint32_t sets : {128u, 500u, 512u}) {
+        std::cout << std::setw(10) << sets
+                  << std::setw(14) << ns_per_index_division(sets)
+                  << std::setw(14) << ns_per_index_indexer(sets) << "\n";
+    }
+
+    std::vector<int> seq_access = generate_access_pattern(NUM_OPS, true);
+    std::cout << "\n== Escenario secuencial (" << NUM_OPS << " ops, Ext3 + Ext4), ns/acceso\n";
+    for (int size : {512, 500}) {
+        for (IndexHash hash : {NO_HASH, XOR_HASH}) {
+            std::string label = std::to_string(size) + (hash == XOR_HASH ? " bloques, XOR" : " bloques");
+            std::cout << std::setw(20) << std::left << label << std::right
+                      << "  directa " << std::setw(8) << sequential_ns([&]() { return DirectMappedCache(size, hash); }, seq_access)
+                      << "  asociativa(4) " << std::setw(8) << sequential_ns([&]() { return SetAssociativeCache(size, 4, hash); }, seq_access)
+                      << "\n";
+        }
+    }
+
+    std::cout << "\n== Patron con paso = numero de conjuntos (64 bloques), % aciertos\n";
+    std::cout << "directa 512        sin hash " << strided_hit_rate(DirectMappedCache(512), 512)
+              << "  XOR " << strided_hit_rate(DirectMappedCache(512, XOR_HASH), 512) << "\n";
+    std::cout << "asociativa 512/4   sin hash " << strided_hit_rate(SetAssociativeCache(512, 4), 128)
+              << "  XOR " << strided_hit_rate(SetAssociativeCache(512, 4, XOR_HASH), 128) << "\n";
+    return 0;
+}
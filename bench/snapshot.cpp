@@ -0,0 +1,80 @@
+// Instantaneas de cache: coste de guardar y de restaurar (mmap) un Ext4 con
+// una cache asociativa de 2^20 bloques ya caliente, y comprobacion de que una
+// ejecucion desde el estado restaurado da los mismos resultados que seguir
+// con la cache original.
+
+#include "Ext4.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Simulator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const int CACHE_BLOCKS = 1 << 20;
+const int BLOCK_SIZE = 4096;
+const int RESTORES = 20;
+const char* PATH = "build/bench_snapshot.bin";
+
+double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+int main() {
+    SetAssociativeCache warm_cache(CACHE_BLOCKS, 8);
+    warm_cache.enable_ghosts(true);
+    Ext4 warm(warm_cache, BLOCK_SIZE);
+
+    // Calentamiento: Zipf sobre 2^21 bloques
+    PhaseSpec phase;
+    phase.ops = 2000000;
+    phase.keys[0].distribution = SCRAMBLED_ZIPF;
+    phase.keys[0].num_blocks = 1 << 21;
+    Workload warmup(BLOCK_SIZE);
+    warmup.add_phase(phase);
+    AdvancedStats stats = {};
+    run_simulation(warm, warmup, stats);
+
+    auto start = std::chrono::steady_clock::now();
+    bool saved = warm.save_snapshot(PATH);
+    double save_ms = ms_since(start);
+
+    SetAssociativeCache fork_cache(CACHE_BLOCKS, 8);
+    Ext4 fork(fork_cache, BLOCK_SIZE);
+    bool restored = true;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RESTORES; ++i) {
+        restored = restored && fork.load_snapshot(PATH);
+    }
+    double restore_ms = ms_since(start) / RESTORES;
+
+    FILE* f = std::fopen(PATH, "rb");
+    long bytes = 0;
+    if (f) {
+        std::fseek(f, 0, SEEK_END);
+        bytes = std::ftell(f);
+        std::fclose(f);
+    }
+
+    // La misma carga desde el estado original y desde el restaurado
+    phase.ops = 200000;
+    Workload experiment(BLOCK_SIZE, 99);
+    experiment.add_phase(phase);
+    AdvancedStats from_warm = {}, from_fork = {};
+    run_simulation(warm, experiment, from_warm);
+    run_simulation(fork, experiment, from_fork);
+    bool same = from_warm.cache_hits == from_fork.cache_hits && from_warm.ghost_hits_4x == from_fork.ghost_hits_4x;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "instantanea        " << bytes / (1024.0 * 1024.0) << " MiB\n";
+    std::cout << "guardar            " << save_ms << " ms" << (saved ? "" : " (fallo)") << "\n";
+    std::cout << "restaurar (mmap)   " << restore_ms << " ms, "
+              << bytes / (restore_ms * 1e-3) / (1024.0 * 1024.0 * 1024.0) << " GiB/s" << (restored ? "" : " (fallo)") << "\n";
+    std::cout << "mismos resultados  " << (same ? "si" : "NO") << " (" << from_fork.cache_hits << " aciertos)\n";
+    std::remove(PATH);
+    return same && saved && restored ? 0 : 1;
+}
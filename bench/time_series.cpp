@@ -0,0 +1,85 @@
+// Coste de la serie temporal por ventanas: la misma carga Zipf sin ventanas,
+// con ventanas de 1000 operaciones en el anillo y volcandolas ademas a CSV y
+// a JSON por lineas. Todas las variantes deben dar el mismo resultado.
+
+#include "Ext4.hpp"
+#include "MetricsWriter.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Simulator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+const int CACHE_BLOCKS = 1 << 16;
+const int BLOCK_SIZE = 4096;
+const long long OPS = 4000000;
+const char* CSV_PATH = "build/bench_time_series.csv";
+const char* JSONL_PATH = "build/bench_time_series.jsonl";
+
+struct Result {
+    double ns_per_op;
+    long long hits;
+    long long windows;
+};
+
+// series == nullptr: sin ventanas
+Result measure(TimeSeries* series) {
+    SetAssociativeCache cache(CACHE_BLOCKS, 8);
+    Ext4 fs(cache, BLOCK_SIZE);
+    PhaseSpec phase;
+    phase.ops = OPS;
+    phase.keys[0].distribution = SCRAMBLED_ZIPF;
+    phase.keys[0].num_blocks = 1 << 18;
+    Workload workload(BLOCK_SIZE);
+    workload.add_phase(phase);
+
+    RunConfig config;
+    config.window_ops = series ? 1000 : 0;
+    config.series = series;
+    AdvancedStats stats = {};
+    auto start = std::chrono::steady_clock::now();
+    run_simulation(fs, workload, stats, config);
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return {ns / OPS, stats.cache_hits, series ? static_cast<long long>(series->size()) + series->dropped() : 0};
+}
+
+}
+
+int main() {
+    Result plain = measure(nullptr);
+
+    TimeSeries ring(256);
+    Result windowed = measure(&ring);
+
+    MetricsWriter csv(METRICS_CSV);
+    TimeSeries to_csv(256);
+    bool opened = csv.open(CSV_PATH);
+    csv.set_label("zipf");
+    to_csv.set_writer(&csv);
+    Result written_csv = measure(&to_csv);
+    csv.close();
+
+    MetricsWriter jsonl(METRICS_JSONL);
+    TimeSeries to_jsonl(256);
+    opened = jsonl.open(JSONL_PATH) && opened;
+    jsonl.set_label("zipf");
+    to_jsonl.set_writer(&jsonl);
+    Result written_jsonl = measure(&to_jsonl);
+    jsonl.close();
+
+    bool same = plain.hits == windowed.hits && plain.hits == written_csv.hits && plain.hits == written_jsonl.hits;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "sin ventanas        " << plain.ns_per_op << " ns/op\n";
+    std::cout << "anillo (256)        " << windowed.ns_per_op << " ns/op, " << windowed.windows << " ventanas, "
+              << ring.dropped() << " fuera del anillo\n";
+    std::cout << "anillo + CSV        " << written_csv.ns_per_op << " ns/op\n";
+    std::cout << "anillo + JSONL      " << written_jsonl.ns_per_op << " ns/op\n";
+    std::cout << "mismos resultados   " << (same ? "si" : "NO") << (opened ? "" : " (no se pudo escribir)") << "\n";
+    std::remove(CSV_PATH);
+    std::remove(JSONL_PATH);
+    return same && opened ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include "FastRandom.hpp"
+#include "PullIterator.hpp"
+
+// Version perezosa de generate_access_pattern: direcciones secuenciales en
+// bloques de 4K o uniformes en [0, 2^24] con semilla 10, sin guardarlas, asi
+// que la memoria no depende del numero de operaciones. Las aleatorias se
+// generan por bloques de BATCH con XoshiroBatch.
+// begin() reinicia el generador, por lo que puede recorrerse varias veces.
+class AccessPattern {
+    private:
+        long long num_ops;
+        bool sequential;
+        long long produced;
+        XoshiroBatch gen;
+        static const int BATCH = 256;
+        uint32_t buffer[BATCH];
+        int buffered;  // Posicion de la siguiente direccion del buffer
+
+    public:
+        AccessPattern(long long num_ops, bool sequential);
+
+        bool next(int& address);
+
+        void rewind();
+
+        long long size() const { return num_ops; }
+
+        PullIterator<AccessPattern, int> begin() {
+            rewind();
+            return PullIterator<AccessPattern, int>(*this);
+        }
+
+        PullIterator<AccessPattern, int> end() { return PullIterator<AccessPattern, int>(); }
+};
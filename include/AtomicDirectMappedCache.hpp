@@ -0,0 +1,51 @@
+#ifndef ATOMICDIRECTMAPPEDCACHE
+#define ATOMICDIRECTMAPPEDCACHE
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "Cache.hpp"
+#include "Stats.hpp"
+
+// Cache por correspondencia directa sin locks.
+// Cada entrada es una palabra atomica de 64 bits que empaqueta
+// {block_id (32 bits altos), dirty (bit 1), valid (bit 0)}: un acierto es una
+// sola carga relajada y una comparacion, y las inserciones y marcas de sucio
+// son operaciones CAS. Cada hilo debe usar su propio AdvancedStats.
+class AtomicDirectMappedCache : public Cache {
+private:
+    static constexpr uint64_t VALID = 1;
+    static constexpr uint64_t DIRTY = 2;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> cache_entries;
+
+    static uint64_t pack(int block_id, uint64_t flags) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(block_id)) << 32) | flags;
+    }
+
+    static bool holds(uint64_t entry, int block_id) {
+        return (entry & VALID) && (entry >> 32) == static_cast<uint32_t>(block_id);
+    }
+
+    std::atomic<uint64_t>& slot(int block_id) const {
+        return cache_entries[static_cast<uint32_t>(block_id) % capacity];
+    }
+
+public:
+    AtomicDirectMappedCache(int size);
+
+    AtomicDirectMappedCache(AtomicDirectMappedCache const &c);
+
+    bool access(int block_id, AdvancedStats& stats) override;
+
+    void add_block(int block_id) override;
+
+    void mark_dirty(int block_id) override;
+
+    void reset() override;
+
+
+    long long dirty_blocks() const override;
+};
+
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include "Cache.hpp"
+#include "Stats.hpp"
+
+// Cache ficticia que solo registra la secuencia de bloques referenciados.
+// Siempre falla, pero como Ext3 y Ext4 consultan los mismos bloques sin
+// importar si aciertan o fallan, la traza registrada es la misma que vería
+// cualquier cache real con las mismas direcciones.
+class TraceRecorder : public Cache {
+    private:
+        std::vector<int> references;
+
+    public:
+        TraceRecorder() : Cache(0) {}
+
+        bool access(int block_id, AdvancedStats& stats) override {
+            references.push_back(block_id);
+            stats.cache_misses++;
+            return false;
+        }
+
+        void add_block(int) override {}
+
+        void mark_dirty(int) override {}
+
+        void reset() override { references.clear(); }
+
+        const std::vector<int>& trace() const { return references; }
+
+        void clear() { references.clear(); }
+};
+
+// Reemplazo optimo fuera de linea (MIN de Belady) para una cache totalmente
+// asociativa de `capacity` bloques: en cada fallo se desaloja el bloque cuyo
+// proximo uso esta mas lejos. Es la cota superior de la tasa de aciertos de
+// cualquier politica con la misma capacidad.
+class BeladyOracle {
+    private:
+        unsigned int capacity;
+
+    public:
+        BeladyOracle(int size) : capacity(size) {}
+
+        // Rellena cache_hits y cache_misses de stats (el resto no se toca)
+        void run(const std::vector<int>& trace, AdvancedStats& stats) const;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <algorithm>
+#include "DiskRequest.hpp"
+
+// Dispositivo de bloques. Atiende las peticiones de una en una sobre su propio
+// reloj (en ms) y acumula en stats.device_time el tiempo de servicio.
+class BlockDevice : public RequestSink {
+    protected:
+        double clock;  // Instante en que el dispositivo queda libre
+
+    public:
+        BlockDevice() : clock(0.0) {}
+
+        // Atiende la peticion llegada en `now` y devuelve el instante en que termina
+        virtual double service(const DiskRequest& request, double now, AdvancedStats& stats) = 0;
+
+        // Instante en que puede empezar una peticion llegada en `now`. Por
+        // defecto el dispositivo atiende de una en una; los que solapan
+        // peticiones internamente devuelven `now`.
+        virtual double start_time(double now) const { return std::max(now, clock); }
+
+        // Peticion llegada en `now` (simulacion por sucesos); devuelve cuando termina
+        double dispatch(const DiskRequest& request, double now, AdvancedStats& stats) {
+            double start = start_time(now);
+            double done = service(request, start, stats);
+            stats.device_time += done - start;
+            stats.issued_requests++;
+            clock = std::max(clock, done);
+            return done;
+        }
+
+        // Sin simulacion por sucesos: cada peticion llega al terminar la anterior
+        void submit(const DiskRequest& request, AdvancedStats& stats) override {
+            dispatch(request, clock, stats);
+        }
+
+        void flush(AdvancedStats&) override {}
+
+        double now() const { return clock; }
+};
@@ -1,24 +1,68 @@
 #ifndef CACHE
 #define CACHE
 
+#include <cstdint>
 #include "Stats.hpp"
 
+class SnapshotWriter;
+class SnapshotReader;
+
+// Los block_id validos van de 0 a MAX_BLOCK_ID. Las caches que guardan el
+// bloque (o su tag) desplazado junto al bit de suciedad en 32 bits no pueden
+// representar los demas: para ellas un block_id fuera de rango siempre falla,
+// no se inserta y mark_dirty lo ignora.
 class Cache {
 
     protected:
         unsigned int capacity; // numero de bloques
+        int tenant;            // Inquilino de los accesos en curso (0 por defecto)
         
     public:
 
-        Cache(int size) : capacity(size) {}
+        static constexpr uint32_t MAX_BLOCK_ID = 0x7ffffffe;  // (MAX_BLOCK_ID << 1) | 1 != UINT32_MAX
+
+        static bool in_range(int block_id) { return static_cast<uint32_t>(block_id) <= MAX_BLOCK_ID; }
+
+        Cache(int size) : capacity(size), tenant(0) {}
 
-        Cache(Cache const &c) : capacity(c.capacity) {}
+        Cache(Cache const &c) : capacity(c.capacity), tenant(c.tenant) {}
+
+        virtual ~Cache() {}
     
         virtual bool access(int block_id, AdvancedStats& stats) = 0;
     
         virtual void add_block(int block_id) = 0;
     
         virtual void mark_dirty(int block_id) = 0;
+
+        // Vacia la cache (y sus listas fantasma) sin cambiar la configuracion
+        virtual void reset() = 0;
+
+        // Bloques sucios en la cache. DirectMappedCache y SetAssociativeCache
+        // llevan un contador y responden en O(1); FullyAssociative, Skewed
+        // (y ZCache), Sharded y AtomicDirectMapped recorren sus entradas, asi
+        // que con ellas conviene muestrear por ventanas y no en cada acceso.
+        // Por defecto (p. ej. TraceRecorder) devuelve 0
+        virtual long long dirty_blocks() const { return 0; }
+
+        // Instantanea del contenido: tags, bits de suciedad y estado de
+        // reemplazo. load exige la misma geometria que la cache guardada y
+        // devuelve false si no coincide; las caches sin soporte no escriben
+        // nada y su load siempre falla.
+        virtual void save(SnapshotWriter&) const {}
+        virtual bool load(SnapshotReader&) { return false; }
+
+        // Los accesos siguientes se atribuyen a este inquilino; solo las caches
+        // con particionado lo usan. false (y sin cambios) fuera de 0..MAX_TENANTS-1
+        bool set_tenant(int t) {
+            if (t < 0 || t >= MAX_TENANTS) {
+                return false;
+            }
+            tenant = t;
+            return true;
+        }
+
+        unsigned int size() const { return capacity; }
 };
 
 #endif
\ No newline at end of file
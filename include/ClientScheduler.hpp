@@ -0,0 +1,99 @@
+#pragma once
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+#include "TimedSimulation.hpp"
+
+// Cliente simulado escrito como corrutina. Arranca suspendido y no se ejecuta
+// hasta que ClientScheduler::spawn lo adopta; el marco se libera al terminar.
+class SimTask {
+    public:
+        struct promise_type {
+            uint32_t id = 0;  // Indice del cliente en el planificador
+
+            SimTask get_return_object() {
+                return SimTask(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        SimTask(SimTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        SimTask(const SimTask&) = delete;
+        ~SimTask() {
+            if (handle) {
+                handle.destroy();
+            }
+        }
+
+        Handle release() {
+            Handle h = handle;
+            handle = nullptr;
+            return h;
+        }
+
+    private:
+        explicit SimTask(Handle h) : handle(h) {}
+        Handle handle;
+};
+
+// Planificador de clientes concurrentes sobre el motor de sucesos. Cada
+// cliente hace co_await de read/write/sleep; la E/S se ejecuta en el sistema
+// de archivos en el instante actual (igual que en TimedSimulation) y el
+// cliente se reanuda con un suceso en el instante en que termina, tambien
+// cuando sus peticiones esperan en el planificador (set_scheduler). El estado
+// de un cliente es su marco de corrutina, asi que decenas de miles de
+// flujos caben sin hilos del sistema.
+class ClientScheduler : public TimedSimulation {
+    private:
+        static constexpr uint32_t RESUME = FIRST_CUSTOM_EVENT;
+
+        std::vector<SimTask::Handle> clients;  // nullptr cuando el cliente ha terminado
+        std::vector<double> io_start;          // Inicio de la E/S en curso; < 0 si no hay
+        AdvancedStats* stats;                  // Solo durante run()
+
+        void io(SimTask::Handle h, int offset, int length, bool write);
+        void wake(SimTask::Handle h, double time) { events.push(time, RESUME, h.promise().id); }
+
+    public:
+        struct IoAwaiter {
+            ClientScheduler& scheduler;
+            int offset;
+            int length;
+            bool write;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(SimTask::Handle h) { scheduler.io(h, offset, length, write); }
+            void await_resume() const noexcept {}
+        };
+
+        struct SleepAwaiter {
+            ClientScheduler& scheduler;
+            double ms;
+
+            bool await_ready() const noexcept { return ms <= 0.0; }
+            void await_suspend(SimTask::Handle h) { scheduler.wake(h, scheduler.now() + ms); }
+            void await_resume() const noexcept {}
+        };
+
+        ClientScheduler(FileSystem& fs, BlockDevice& device, const TimingConfig& cfg = TimingConfig());
+        ~ClientScheduler();
+
+        // Registra el cliente; empieza en el instante actual si run() esta en curso
+        void spawn(SimTask task);
+
+        // Ejecuta hasta que terminan todos los clientes
+        void run(AdvancedStats& stats);
+
+        IoAwaiter read(int offset, int length = 1) { return {*this, offset, length, false}; }
+        IoAwaiter write(int offset, int length = 1) { return {*this, offset, length, true}; }
+        SleepAwaiter sleep(double ms) { return {*this, ms}; }
+
+        double now() const { return events.now(); }
+        int live_clients() const { return in_flight; }
+};
@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include <utility>
+#include <vector>
+
+// Seccion de un fichero INI, con sus pares clave = valor en orden
+struct ConfigSection {
+    std::string name;  // Vacio para las claves anteriores a la primera seccion
+    std::vector<std::pair<std::string, std::string>> entries;
+};
+
+// Lector de ficheros INI minimo: secciones [nombre], lineas clave = valor,
+// comentarios con '#' o ';' al principio de la linea o tras un espacio.
+// Los espacios alrededor de claves y valores se ignoran.
+class ConfigFile {
+    private:
+        std::vector<ConfigSection> parsed;
+
+    public:
+        // false (con el motivo y la linea en `error`) si no se puede leer o
+        // tiene lineas mal formadas
+        bool load(const std::string& path, std::string& error);
+        bool parse(const std::string& text, std::string& error);
+
+        const std::vector<ConfigSection>& sections() const { return parsed; }
+};
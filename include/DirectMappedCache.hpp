@@ -1,24 +1,41 @@
 #ifndef DIRECTMAPPEDCACHE
 #define DIRECTMAPPEDCACHE
 
+#include <cstdint>
 #include <vector>
 #include "Cache.hpp"
+#include "SetIndex.hpp"
+#include "TinyLFU.hpp"
 #include "Stats.hpp"
 
 class DirectMappedCache : public Cache {
 
 private:
-struct CacheEntry {
-    int block_id;
-    bool dirty;
-    bool valid;  // Indica si la entrada contiene datos válidos
-};
+// Cada entrada ocupa una palabra de 32 bits: (tag << 1) | dirty.
+// El indice ya implica el resto del bloque, asi que solo se guarda su tag
+// (block_id / capacity). Una entrada invalida vale EMPTY.
+// Los block_id fuera de Cache::in_range fallan y no se insertan.
+static constexpr uint32_t DIRTY = 1;
+static constexpr uint32_t EMPTY = UINT32_MAX;
+
+SetIndexer indexer;
+std::vector<uint32_t> cache_entries;  // Usamos un vector para acceso directo
+long long dirty;  // Entradas con el bit de suciedad, para dirty_blocks() en O(1)
+TinyLFU* admission;  // Filtro de admision opcional (no es propiedad de la cache)
+
+// Caches sombra de solo tags con 2x y 4x entradas (vacias si estan desactivadas).
+// Reciben los mismos accesos que la cache real y cuentan los fallos de esta
+// que habrian sido aciertos con mas capacidad.
+SetIndexer shadow_2x_indexer;
+SetIndexer shadow_4x_indexer;
+std::vector<uint32_t> shadow_2x;
+std::vector<uint32_t> shadow_4x;
 
-std::vector<CacheEntry> cache_entries;  // Usamos un vector para acceso directo
+static bool shadow_access(std::vector<uint32_t>& shadow, const SetIndexer& idx, int block_id);
 
 public:
     
-    DirectMappedCache(int size);
+    DirectMappedCache(int size, IndexHash hash = NO_HASH);
 
     DirectMappedCache(DirectMappedCache const &c);
 
@@ -27,5 +44,22 @@ public:
     void add_block(int block_id) override;
 
     void mark_dirty(int block_id) override;
+
+    void reset() override;
+
+
+    long long dirty_blocks() const override { return dirty; }
+
+    void save(SnapshotWriter& out) const override;
+
+    bool load(SnapshotReader& in) override;
+
+    // Activa o desactiva las caches sombra (stats.ghost_hits_2x / ghost_hits_4x).
+    // Desactivadas solo cuestan una comprobacion por acceso.
+    void enable_ghosts(bool enabled);
+
+    // Con un filtro, un bloque que falla solo reemplaza al ocupante de su
+    // entrada si es mas frecuente; nullptr lo desactiva
+    void set_admission_filter(TinyLFU* filter);
 };
-#endif
\ No newline at end of file
+#endif
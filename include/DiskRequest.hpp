@@ -0,0 +1,19 @@
+#pragma once
+#include "Stats.hpp"
+
+// Peticion al dispositivo: num_blocks bloques contiguos desde first_block
+struct DiskRequest {
+    int first_block;
+    int num_blocks;
+    bool write;
+    long long arrival;  // Numero de orden de llegada al planificador
+};
+
+// Destino de las peticiones de disco de un sistema de archivos
+class RequestSink {
+    public:
+        virtual ~RequestSink() {}
+        virtual void submit(const DiskRequest& request, AdvancedStats& stats) = 0;
+        // Despachar todo lo pendiente (fin de la simulacion, sync)
+        virtual void flush(AdvancedStats& stats) = 0;
+};
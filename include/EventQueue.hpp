@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Suceso con marca de tiempo (ms simulados). type y data los interpreta quien
+// consume la cola; seq desempata los sucesos simultaneos en orden de llegada
+// para que la simulacion sea determinista.
+struct Event {
+    double time;
+    uint64_t seq;
+    uint32_t type;
+    uint32_t data;
+};
+
+// Cola de prioridad de sucesos: monticulo 4-ario sobre un vector plano. Con
+// cuatro hijos por nodo el monticulo tiene la mitad de niveles que uno binario
+// y los hijos de un nodo comparten linea de cache, lo que abarata pop().
+class EventQueue {
+    private:
+        std::vector<Event> heap;
+        uint64_t next_seq;
+        double clock;
+
+        static bool before(const Event& a, const Event& b) {
+            return a.time < b.time || (a.time == b.time && a.seq < b.seq);
+        }
+
+    public:
+        EventQueue() : next_seq(0), clock(0.0) {}
+
+        void push(double time, uint32_t type, uint32_t data) {
+            Event ev{time, next_seq++, type, data};
+            size_t i = heap.size();
+            heap.push_back(ev);
+            while (i > 0) {
+                size_t parent = (i - 1) / 4;
+                if (!before(ev, heap[parent])) {
+                    break;
+                }
+                heap[i] = heap[parent];
+                i = parent;
+            }
+            heap[i] = ev;
+        }
+
+        // Saca el suceso mas temprano y avanza el reloj hasta el
+        bool pop(Event& out) {
+            if (heap.empty()) {
+                return false;
+            }
+            out = heap[0];
+            clock = out.time;
+
+            Event last = heap.back();
+            heap.pop_back();
+            size_t n = heap.size();
+            if (n == 0) {
+                return true;
+            }
+            size_t i = 0;
+            for (;;) {
+                size_t child = 4 * i + 1;
+                if (child >= n) {
+                    break;
+                }
+                size_t best = child;
+                size_t end = child + 4 < n ? child + 4 : n;
+                for (size_t c = child + 1; c < end; ++c) {
+                    if (before(heap[c], heap[best])) {
+                        best = c;
+                    }
+                }
+                if (!before(heap[best], last)) {
+                    break;
+                }
+                heap[i] = heap[best];
+                i = best;
+            }
+            heap[i] = last;
+            return true;
+        }
+
+        double now() const { return clock; }
+        bool empty() const { return heap.empty(); }
+        size_t size() const { return heap.size(); }
+        void reserve(size_t n) { heap.reserve(n); }
+
+        void clear() {
+            heap.clear();
+            next_seq = 0;
+            clock = 0.0;
+        }
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ConfigFile.hpp"
+#include "ResultsWriter.hpp"
+#include "Stats.hpp"
+
+// Un escenario completo: cache, sistema de archivos, cola y dispositivo, y
+// carga. Los campos de texto admiten los valores indicados; set_scenario_field
+// los valida.
+struct ScenarioSpec {
+    std::string name = "escenario";
+    std::string cache = "set_associative";  // direct_mapped, set_associative, fully_associative, skewed, zcache
+    int capacity = 512;                     // Bloques
+    int ways = 4;                           // set_associative, skewed y zcache
+    bool ghosts = false;                    // Listas fantasma (direct_mapped y set_associative)
+    std::string filesystem = "ext4";        // ext3, ext4
+    std::string journaling = "default";     // none, metadata, full (solo ext3) o el propio del sistema de archivos
+    int block_size = 4096;
+    std::string scheduler = "none";         // none, noop, deadline, mq_deadline, bfq
+    std::string device = "none";            // none, hdd, ssd
+    // uniform, zipf, scrambled_zipf, hotspot, latest, sequential (Workload) o
+    // secuencial, aleatorio (los patrones fijos de AccessPattern). Los patrones
+    // fijos no usan blocks, theta, drift_every, drift_step ni seed: barrer esas
+    // claves con ellos repite el mismo escenario.
+    std::string workload = "zipf";
+    long long ops = 10000;
+    int blocks = 1 << 12;                   // Espacio de bloques de la carga
+    double write_ratio = 0.2;
+    double theta = 0.99;                    // Zipf; 1 usa la forma limite de ZipfGenerator
+    long long drift_every = 0;
+    int drift_step = 0;
+    uint64_t seed = 10;
+    long long warmup_ops = 0;
+};
+
+// Asigna un campo por su nombre (el mismo que en ScenarioSpec); false si la
+// clave no existe o el valor no es valido
+bool set_scenario_field(ScenarioSpec& spec, const std::string& key, const std::string& value, std::string& error);
+
+// Barrido: producto cartesiano de listas de valores por clave. Los escenarios
+// no se materializan: at() decodifica el indice como un numero en base mixta
+// (la ultima clave es la que cambia mas deprisa), asi que un barrido de
+// millones de combinaciones ocupa lo mismo que uno de una.
+class ScenarioSweep {
+    private:
+        struct Axis {
+            std::string key;
+            std::vector<std::string> values;
+        };
+
+        std::string name;
+        std::vector<Axis> axes;
+
+    public:
+        explicit ScenarioSweep(const std::string& n) : name(n) {}
+
+        // Lista separada por comas; cada elemento es un valor o un rango
+        // a..b (paso 1), a..b+paso o a..b*factor. Sustituye a lo que hubiera
+        // para la clave. Un rango vacio (b < a) es un error.
+        bool set(const std::string& key, const std::string& values, std::string& error);
+
+        long long size() const;
+        const std::string& label() const { return name; }
+
+        // Escenario numero `index` (0 <= index < size())
+        ScenarioSpec at(long long index) const;
+};
+
+// Un barrido por seccion del fichero; las claves de [defaults] (o anteriores a
+// la primera seccion) valen para todas, y `overrides` (p. ej. de la linea de
+// ordenes) se aplica al final. Sin secciones propias queda un unico barrido.
+bool build_sweeps(const ConfigFile& config, const std::vector<std::pair<std::string, std::string>>& overrides,
+                  std::vector<ScenarioSweep>& sweeps, std::string& error);
+
+// Construye el escenario con las clases del simulador y lo ejecuta; false si
+// la combinacion no es valida
+bool run_scenario(const ScenarioSpec& spec, AdvancedStats& stats, std::string& error);
+
+RunDescription describe(const ScenarioSpec& spec);
+
+// Ejecuta todos los escenarios con `threads` hilos y entrega los resultados a
+// `results` en el orden de los barridos. Los fallidos se notifican en
+// `errors` y no producen fila; un barrido sin escenarios cuenta como un
+// fallido. Devuelve el numero de fallidos.
+long long run_sweeps(const std::vector<ScenarioSweep>& sweeps, int threads, ResultsWriter& results,
+                     std::ostream& errors);
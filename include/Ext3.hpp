@@ -8,13 +8,28 @@ class Ext3 : public FileSystem {
         Cache& cache;
         bool has_journal;
         
-        void journal_operation(int address, AdvancedStats& stats);
+        void journal_operation(AdvancedStats& stats);
+        void metadata_access(AdvancedStats& stats);
     public:
         Ext3(Cache& c, int bs);
+
+        using FileSystem::read;
+        using FileSystem::write;
     
-        void read(int address, AdvancedStats& stats) override;
+        void read(int offset, int length, AdvancedStats& stats) override;
     
-        void write(int address, AdvancedStats& stats) override;
+        void write(int offset, int length, AdvancedStats& stats) override;
     
         void set_journal_mode(JournalingMode mode) override;
-    };
\ No newline at end of file
+
+        bool set_tenant(int tenant) override { return cache.set_tenant(tenant); }
+
+        void reset() override { cache.reset(); }
+
+        long long dirty_blocks() const override { return cache.dirty_blocks(); }
+        unsigned int cache_size() const override { return cache.size(); }
+
+        void save(SnapshotWriter& out) const override;
+
+        bool load(SnapshotReader& in) override;
+    };
@@ -8,13 +8,27 @@ class Ext4 : public FileSystem {
         Cache& cache;
         bool delayed_allocation;
         
-        void extent_access(int address, AdvancedStats& stats);
+        void extent_access(int first_block, int last_block, AdvancedStats& stats);
     public:
         Ext4(Cache& c, int bs);
+
+        using FileSystem::read;
+        using FileSystem::write;
     
-        void read(int address, AdvancedStats& stats) override;
+        void read(int offset, int length, AdvancedStats& stats) override;
     
-        void write(int address, AdvancedStats& stats) override;
+        void write(int offset, int length, AdvancedStats& stats) override;
     
         void set_journal_mode(JournalingMode mode) override;
-    };
\ No newline at end of file
+
+        bool set_tenant(int tenant) override { return cache.set_tenant(tenant); }
+
+        void reset() override { cache.reset(); }
+
+        long long dirty_blocks() const override { return cache.dirty_blocks(); }
+        unsigned int cache_size() const override { return cache.size(); }
+
+        void save(SnapshotWriter& out) const override;
+
+        bool load(SnapshotReader& in) override;
+    };
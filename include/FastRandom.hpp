@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Generadores rapidos para la carga sintetica.
+//
+// Xoshiro256pp es xoshiro256++ (Blackman y Vigna) sembrado con splitmix64: una
+// semilla fija da siempre la misma secuencia. Cumple los requisitos de
+// UniformRandomBitGenerator, asi que tambien sirve con las distribuciones de
+// <random>, aunque bounded() y uniform() son mucho mas baratas.
+//
+// XoshiroBatch mantiene LANES generadores independientes (separados con
+// jump(), 2^128 pasos) en formato estructura de arreglos para que el
+// compilador vectorice el relleno de bloques.
+
+class Xoshiro256pp {
+    private:
+        uint64_t s[4];
+
+        static uint64_t rotl(uint64_t x, int k) {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        using result_type = uint64_t;
+
+        explicit Xoshiro256pp(uint64_t seed = 0) { this->seed(seed); }
+
+        void seed(uint64_t seed) {
+            for (uint64_t& word : s) {
+                // splitmix64
+                uint64_t z = (seed += 0x9e3779b97f4a7c15ull);
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return UINT64_MAX; }
+
+        uint64_t operator()() {
+            uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+            uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+
+        // Entero uniforme en [0, range) sin sesgo (Lemire): una multiplicacion y,
+        // casi nunca, una division para el rechazo
+        uint32_t bounded(uint32_t range) {
+            uint64_t m = ((*this)() >> 32) * range;
+            uint32_t low = static_cast<uint32_t>(m);
+            if (low < range) {
+                uint32_t threshold = -range % range;
+                while (low < threshold) {
+                    m = ((*this)() >> 32) * range;
+                    low = static_cast<uint32_t>(m);
+                }
+            }
+            return m >> 32;
+        }
+
+        // Real uniforme en [0, 1) con 53 bits
+        double uniform() {
+            return ((*this)() >> 11) * 0x1.0p-53;
+        }
+
+        // Avanza 2^128 pasos: genera subsecuencias que no se solapan
+        void jump();
+
+        void state(uint64_t out[4]) const {
+            for (int i = 0; i < 4; ++i) {
+                out[i] = s[i];
+            }
+        }
+};
+
+class XoshiroBatch {
+    public:
+        static const int LANES = 8;
+
+    private:
+        uint64_t s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+        Xoshiro256pp scalar;  // Para los rechazos de bounded (muy raros)
+
+    public:
+        explicit XoshiroBatch(uint64_t seed = 0);
+
+        void seed(uint64_t seed);
+
+        // Rellena out con n valores de 64 bits
+        void fill(uint64_t* out, size_t n);
+
+        // Rellena out con n enteros uniformes en [0, range) sin sesgo
+        void fill_bounded(uint32_t* out, size_t n, uint32_t range);
+};
@@ -1,18 +1,86 @@
 #pragma once
+#include <string>
+#include <vector>
+#include "Cache.hpp"
+#include "IOScheduler.hpp"
 #include "JournalingMode.hpp"
 #include "Stats.hpp"
 
 // base abstracta wasa
 class FileSystem {
     protected:
+        // Tramo de bloques contiguos
+        struct BlockRun {
+            int first_block;
+            int num_blocks;
+        };
+
         int block_size;
         JournalingMode journal_mode;
         bool use_extents;
-        
+        std::vector<BlockRun> missing;  // Reutilizado entre peticiones
+        RequestSink* sink;              // Planificador de E/S; nullptr: peticiones directas al disco
+
+        // Una peticion al disco de num_blocks bloques contiguos; pasa por el
+        // planificador si hay uno
+        void disk_read(int first_block, int num_blocks, AdvancedStats& stats);
+        void disk_write(int first_block, int num_blocks, AdvancedStats& stats);
+
+        // Consulta en la cache los bloques [first_block, last_block] como un lote,
+        // inserta los que faltan y deja en `missing` los tramos contiguos ausentes
+        void lookup_range(Cache& cache, int first_block, int last_block, AdvancedStats& stats);
+
+        int first_block_of(int offset) const { return offset / block_size; }
+        int last_block_of(int offset, int length) const {
+            return (offset + (length > 0 ? length : 1) - 1) / block_size;
+        }
+
     public:
-        FileSystem(int bs) : block_size(bs) {}
+        FileSystem(int bs) : block_size(bs), journal_mode(NO_JOURNALING), use_extents(false), sink(nullptr) {}
         virtual ~FileSystem() {}
-        virtual void read(int address, AdvancedStats& stats) = 0;
-        virtual void write(int address, AdvancedStats& stats) = 0;
+
+        // Acceso al bloque que contiene address
+        void read(int address, AdvancedStats& stats) { read(address, 1, stats); }
+        void write(int address, AdvancedStats& stats) { write(address, 1, stats); }
+
+        // Peticion de `length` bytes a partir de `offset`, que puede abarcar
+        // varios bloques
+        virtual void read(int offset, int length, AdvancedStats& stats) = 0;
+        virtual void write(int offset, int length, AdvancedStats& stats) = 0;
+
         virtual void set_journal_mode(JournalingMode mode) = 0;
-};
\ No newline at end of file
+        JournalingMode journaling() const { return journal_mode; }
+
+        // Inquilino al que pertenecen las peticiones siguientes; false si esta
+        // fuera de rango (ver Cache::set_tenant)
+        virtual bool set_tenant(int tenant) = 0;
+
+        // Vacia la cache; la configuracion (journal, planificador) se conserva
+        virtual void reset() = 0;
+
+        // Bloques sucios en la cache y capacidad de esta
+        virtual long long dirty_blocks() const = 0;
+        virtual unsigned int cache_size() const = 0;
+
+        // Estado completo: configuracion del sistema de archivos seguida del
+        // contenido de su cache. load devuelve false si la instantanea no
+        // corresponde a este sistema de archivos o a la geometria de su cache,
+        // y en ese caso el estado puede haber quedado a medias: conviene
+        // llamar a reset().
+        virtual void save(SnapshotWriter& out) const;
+        virtual bool load(SnapshotReader& in);
+
+        // Instantanea en fichero; la carga proyecta el fichero con mmap
+        bool save_snapshot(const std::string& path) const;
+        bool load_snapshot(const std::string& path);
+
+        void set_io_scheduler(RequestSink* scheduler) { sink = scheduler; }
+        RequestSink* io_scheduler() const { return sink; }
+
+        // Vacia la cola del planificador
+        void sync(AdvancedStats& stats) {
+            if (sink) {
+                sink->flush(stats);
+            }
+        }
+};
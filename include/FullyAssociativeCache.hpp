@@ -0,0 +1,76 @@
+#ifndef FULLYASSOCIATIVECACHE
+#define FULLYASSOCIATIVECACHE
+
+#include <cstdint>
+#include <vector>
+#include "Cache.hpp"
+#include "Stats.hpp"
+
+// Cache totalmente asociativa con reemplazo LRU exacto en O(1).
+// Los bloques viven en un arreglo de ranuras preasignado y enlazado por
+// indices de 32 bits (lista LRU intrusiva). Un hash de direccionamiento
+// abierto con Robin Hood mapea block_id -> ranura. Un acierto cuesta una
+// busqueda en el hash y unas pocas escrituras de indices; no se reserva
+// memoria despues del constructor.
+class FullyAssociativeCache : public Cache {
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Slot {
+        uint32_t block;  // block_id completo (32 bits, tambien negativos)
+        uint32_t prev;   // Hacia el mas recientemente usado
+        uint32_t next;   // Hacia el menos recientemente usado
+        bool dirty;
+    };
+
+    struct Bucket {
+        uint32_t block;
+        uint32_t slot;   // NIL si el bucket esta vacio
+    };
+
+    std::vector<Slot> slots;
+    std::vector<Bucket> table;  // Tamano potencia de dos, factor de carga <= 0.5
+    uint32_t table_mask;
+    unsigned int table_shift;
+    uint32_t head;  // MRU
+    uint32_t tail;  // LRU
+    uint32_t used;
+
+    uint32_t home(uint32_t block) const {
+        return (block * 0x9e3779b9u) >> table_shift;  // Hash de Fibonacci
+    }
+
+    uint32_t distance(uint32_t pos) const {
+        return (pos - home(table[pos].block)) & table_mask;
+    }
+
+    uint32_t find(uint32_t block) const;  // Posicion en table o NIL
+    void table_insert(uint32_t block, uint32_t slot);
+    void table_erase(uint32_t pos);
+
+    void unlink(uint32_t slot);
+    void push_front(uint32_t slot);
+
+public:
+    // Una capacidad menor que 1 se trata como 1
+    FullyAssociativeCache(int size);
+
+    FullyAssociativeCache(FullyAssociativeCache const &c);
+
+    bool access(int block_id, AdvancedStats& stats) override;
+
+    void add_block(int block_id) override;
+
+    void mark_dirty(int block_id) override;
+
+    void reset() override;
+
+
+    long long dirty_blocks() const override;
+
+    void save(SnapshotWriter& out) const override;
+
+    bool load(SnapshotReader& in) override;
+};
+
+#endif
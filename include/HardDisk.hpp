@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "BlockDevice.hpp"
+
+struct HardDiskGeometry {
+    int cylinders = 65536;
+    int heads = 4;
+    int zones = 16;
+    int outer_blocks_per_track = 400;  // Bloques de 4KB por pista en la zona exterior
+    int inner_blocks_per_track = 200;
+    double rpm = 7200.0;
+    double min_seek_ms = 0.5;   // Pista a pista
+    double max_seek_ms = 15.0;  // Recorrido completo
+    double settle_ms = 0.1;
+};
+
+// Disco duro: el tiempo de una peticion es busqueda + latencia rotacional +
+// transferencia. La busqueda sigue una curva raiz cuadrada de la distancia en
+// cilindros; la rotacion depende de la posicion angular del plato en el
+// instante de llegada al cilindro, asi que las peticiones contiguas no
+// esperan una vuelta. Las zonas exteriores tienen mas bloques por pista y
+// transfieren mas rapido.
+class HardDisk : public BlockDevice {
+    private:
+        struct Zone {
+            long long first_block;
+            int first_cylinder;
+            int blocks_per_track;
+        };
+
+        HardDiskGeometry geometry;
+        std::vector<Zone> zone_table;
+        long long capacity;   // Bloques
+        double revolution_ms;
+        int current_cylinder;
+
+        const Zone& zone_of(long long block) const;
+        double seek_time(int distance) const;
+
+    public:
+        HardDisk(const HardDiskGeometry& geo = HardDiskGeometry());
+
+        double service(const DiskRequest& request, double now, AdvancedStats& stats) override;
+
+        long long capacity_blocks() const { return capacity; }
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include "DiskRequest.hpp"
+
+enum SchedulerPolicy {
+    NOOP,         // FIFO con fusion de peticiones adyacentes
+    DEADLINE,     // Ascensor por bloque con vencimiento por antiguedad y preferencia de lecturas
+    MQ_DEADLINE,  // Igual que DEADLINE pero despacha lotes de fifo_batch peticiones
+    BFQ_LITE      // Turnos por presupuesto (en bloques) entre la cola de lecturas y la de escrituras
+};
+
+struct SchedulerConfig {
+    SchedulerPolicy policy = DEADLINE;
+    int queue_depth = 32;          // Peticiones retenidas antes de despachar
+    int max_request_blocks = 128;  // Tamano maximo de una peticion fusionada
+    long long read_expire = 500;   // Vencimiento, en peticiones llegadas desde la suya
+    long long write_expire = 5000;
+    int writes_starved = 2;        // Lotes de lecturas antes de atender escrituras pendientes
+    int fifo_batch = 16;
+    int bfq_budget = 256;          // Bloques por turno en BFQ_LITE
+};
+
+// Cola del dispositivo: recoge las peticiones de lectura y escritura, fusiona
+// las adyacentes del mismo tipo (por delante y por detras) y las despacha en
+// el orden de la politica cuando se llena la cola. En las estadisticas,
+// merged_requests cuenta las fusiones e issued_requests las peticiones que
+// llegan realmente al dispositivo.
+class IOScheduler : public RequestSink {
+    private:
+        SchedulerConfig config;
+        RequestSink* device;   // nullptr: las peticiones solo se cuentan
+        std::vector<DiskRequest> queue;
+        // Peticiones originales (su numero de llegada) que forman cada una de
+        // la cola: lista enlazada por la posicion en members, paralela a queue
+        struct Member {
+            long long arrival;
+            int next;  // -1: ultima
+        };
+        std::vector<int> chain;
+        std::vector<Member> members;
+        std::vector<int> free_members;
+        long long arrivals;
+        int head;              // Bloque siguiente al ultimo despachado
+        int starved;           // Despachos de lecturas con escrituras esperando
+        bool serving_writes;   // BFQ_LITE: cola en turno
+        int budget_left;
+
+        int pick_fifo() const;
+        int pick_elevator(bool writes) const;
+        int pick_deadline();
+        int pick_bfq();
+        void dispatch_one(AdvancedStats& stats);
+
+    protected:
+        // Entrega al dispositivo
+        virtual void issue(const DiskRequest& request, AdvancedStats& stats);
+
+    public:
+        IOScheduler(const SchedulerConfig& cfg = SchedulerConfig());
+
+        void submit(const DiskRequest& request, AdvancedStats& stats) override;
+
+        void flush(AdvancedStats& stats) override;
+
+        void set_device(RequestSink* target) { device = target; }
+
+        // Para quien decide cuando despachar (la simulacion por sucesos, que
+        // toma una peticion cada vez que el dispositivo queda libre): enqueue
+        // encola con fusion sin despachar nada y devuelve el numero de llegada
+        // que identifica a la peticion; take saca la siguiente segun la
+        // politica (false si la cola esta vacia) y, con `merged`, deja en el
+        // los numeros de llegada de las peticiones fusionadas en ella
+        long long enqueue(const DiskRequest& request, AdvancedStats& stats);
+        bool take(DiskRequest& request, std::vector<long long>* merged = nullptr);
+
+        int pending() const { return queue.size(); }
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "TimeSeries.hpp"
+
+enum MetricsFormat {
+    METRICS_CSV,
+    METRICS_JSONL  // Un objeto JSON por linea
+};
+
+// Escritor de ventanas a fichero con un buffer propio de tamano fijo: cada
+// ventana se formatea directamente en el buffer, sin reservar memoria, y solo
+// se llama a fwrite cuando se llena o en flush(). La etiqueta (p. ej. el
+// nombre del escenario) acompana a cada fila para distinguir ejecuciones
+// que comparten fichero.
+class MetricsWriter {
+    private:
+        MetricsFormat format;
+        std::FILE* file;
+        std::vector<char> buffer;
+        size_t used;
+        bool header_pending;
+        std::string label;
+
+        void append(const char* text, size_t length);
+
+    public:
+        explicit MetricsWriter(MetricsFormat fmt, size_t buffer_bytes = 1 << 16);
+        ~MetricsWriter();
+
+        MetricsWriter(const MetricsWriter&) = delete;
+        MetricsWriter& operator=(const MetricsWriter&) = delete;
+
+        // Crea (o trunca) el fichero; false si no se puede abrir
+        bool open(const std::string& path);
+        void close();
+        bool is_open() const { return file != nullptr; }
+
+        void set_label(const std::string& l);
+
+        void write(const WindowSample& sample);
+        void flush();
+
+        // Formato segun la extension: .jsonl/.json es JSON por lineas, el resto CSV
+        static MetricsFormat format_for(const std::string& path);
+};
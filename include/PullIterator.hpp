@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+
+// Iterador de entrada sobre un generador "pull": cualquier clase con
+// bool next(T&) (devuelve false al agotarse). Permite recorrer generadores
+// con un for de rango sin materializar la secuencia.
+template <typename Generator, typename T>
+class PullIterator {
+    private:
+        Generator* generator;  // nullptr en el iterador final
+        T current;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        PullIterator() : generator(nullptr), current() {}
+
+        explicit PullIterator(Generator& g) : generator(&g), current() {
+            ++*this;
+        }
+
+        reference operator*() const { return current; }
+        pointer operator->() const { return &current; }
+
+        PullIterator& operator++() {
+            if (generator && !generator->next(current)) {
+                generator = nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const PullIterator& other) const { return generator == other.generator; }
+        bool operator!=(const PullIterator& other) const { return generator != other.generator; }
+};
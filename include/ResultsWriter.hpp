@@ -0,0 +1,67 @@
+#pragma once
+#include <ostream>
+#include <string>
+#include <vector>
+#include "JournalingMode.hpp"
+#include "Stats.hpp"
+
+enum ResultsFormat {
+    RESULTS_TABLE,       // Tablas de tabulate (la salida de siempre)
+    RESULTS_JSON,
+    RESULTS_CSV,
+    RESULTS_PROMETHEUS   // Formato de exposicion de texto de Prometheus
+};
+
+// Configuracion de una ejecucion, tal y como aparece junto a sus estadisticas
+struct RunDescription {
+    std::string scenario;    // Nombre de la ejecucion, p. ej. "secuencial"
+    std::string workload;    // Carga, p. ej. "zipf"
+    long long ops = 0;
+    double write_ratio = 0.0;
+    std::string filesystem;  // "ext3", "ext4"
+    std::string cache;       // "direct_mapped", "set_associative", "belady"...
+    int capacity = 0;        // Bloques
+    int ways = 1;
+    int block_size = 0;      // Bytes
+    JournalingMode journaling = NO_JOURNALING;
+    std::string scheduler;   // "deadline"... o vacio sin planificador
+    std::string device;      // "hdd", "ssd" o vacio sin modelo de dispositivo
+    int tenant = -1;         // -1: todos los inquilinos
+};
+
+// Resultados por ejecucion: cada una es una fila con su configuracion y
+// todos los campos de AdvancedStats. CSV y JSON se escriben al anadir cada
+// fila, asi que la memoria no crece con el numero de ejecuciones; Prometheus
+// exige agrupar las muestras por metrica y la tabla necesita todas las filas
+// para dar ancho a las columnas, asi que en esos formatos se acumulan hasta
+// finish().
+class ResultsWriter {
+    private:
+        struct Row {
+            RunDescription run;
+            AdvancedStats stats;
+        };
+
+        ResultsFormat format;
+        std::ostream& out;
+        std::vector<Row> rows;
+        long long written;  // Filas ya escritas (CSV y JSON)
+
+        void write_json_row(const RunDescription& run, const AdvancedStats& stats);
+        void write_csv_row(const RunDescription& run, const AdvancedStats& stats);
+        void write_prometheus();
+        void write_table();
+
+    public:
+        ResultsWriter(ResultsFormat fmt, std::ostream& os) : format(fmt), out(os), written(0) {}
+
+        void add(const RunDescription& run, const AdvancedStats& stats);
+
+        // Cierra el documento (y escribe lo acumulado); se puede volver a usar
+        void finish();
+
+        // "tabla", "json", "csv" o "prometheus"; false si no es ninguno
+        static bool parse_format(const std::string& name, ResultsFormat& fmt);
+};
+
+const char* journaling_name(JournalingMode mode);
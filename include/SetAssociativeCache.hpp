@@ -1,27 +1,54 @@
 #ifndef SETASSOCIATIVECACHE
 #define SETASSOCIATIVECACHE
 
-#include <list>
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
 #include "Stats.hpp"
 #include "Cache.hpp"
+#include "SetIndex.hpp"
+#include "TinyLFU.hpp"
 
 class SetAssociativeCache : public Cache {
 private:
-    struct CacheEntry {
-        int block_id;
-        bool dirty;
-        std::list<int>::iterator lru_it;  // Iterador para la lista LRU del conjunto
-    };
+    // Cada entrada ocupa una palabra de 32 bits: (tag << 1) | dirty, con
+    // tag = block_id / num_sets (el conjunto ya implica el resto).
+    // Las vias de cada conjunto se guardan contiguas y ordenadas de la mas a la
+    // menos recientemente usada, por lo que el orden LRU no ocupa memoria extra;
+    // las entradas invalidas (EMPTY) quedan siempre al final del conjunto.
+    // Los block_id fuera de Cache::in_range fallan y no se insertan.
+    static constexpr uint32_t DIRTY = 1;
+    static constexpr uint32_t EMPTY = UINT32_MAX;
 
     int num_sets;      // Número de conjuntos (sets)
     unsigned int ways;          // Número de vías (ways) por conjunto
-    std::vector<std::list<int>> lru_lists;  // Listas LRU por conjunto
-    std::vector<std::unordered_map<int, CacheEntry>> cache_maps;  // Mapas por conjunto
+    SetIndexer indexer;
+    std::vector<uint32_t> cache_entries;  // num_sets * ways entradas
+    long long dirty;  // Entradas con el bit de suciedad, para dirty_blocks() en O(1)
+    TinyLFU* admission;  // Filtro de admision opcional (no es propiedad de la cache)
+
+    // Listas fantasma: tags de los ultimos 3 * ways bloques desalojados de cada
+    // conjunto, de mas a menos reciente. Vacio si estan desactivadas.
+    std::vector<uint32_t> ghost_entries;
+
+    // Particionado entre inquilinos: propietario de cada entrada (en paralelo a
+    // cache_entries, mismo orden) y limites por inquilino. Vacio sin particionado.
+    std::vector<uint8_t> owners;
+    std::vector<unsigned int> way_limit;  // Vias por conjunto; 0 = sin limite
+    std::vector<long long> quota;         // Bloques en toda la cache; 0 = sin limite
+    std::vector<long long> occupancy;     // Bloques de cada inquilino en la cache
+
+    // Posicion del bloque dentro de su conjunto o -1 si no esta
+    int find(const uint32_t* set, uint32_t tag) const;
+
+    // Posicion a desalojar para insertar un bloque del inquilino actual
+    int victim_way(const uint32_t* set, const uint8_t* owner) const;
+    unsigned int limit_of(int t) const {
+        return t < static_cast<int>(way_limit.size()) && way_limit[t] > 0 ? way_limit[t] : ways;
+    }
+    void enable_partitioning(int t);
 
 public:
-    SetAssociativeCache(int size, int num_ways);
+    SetAssociativeCache(int size, int num_ways, IndexHash hash = NO_HASH);
 
     SetAssociativeCache(SetAssociativeCache const &c);
 
@@ -30,6 +57,41 @@ public:
     void add_block(int block_id) override;
 
     void mark_dirty(int block_id) override;
+
+    // Tambien vacia la ocupacion por inquilino; los limites se conservan
+    void reset() override;
+
+    long long dirty_blocks() const override { return dirty; }
+
+    void save(SnapshotWriter& out) const override;
+
+    bool load(SnapshotReader& in) override;
+
+    // Un fallo encontrado en la posicion p de la lista fantasma habria acertado
+    // con ways + p + 1 vias por conjunto (LRU es un algoritmo de pila), lo que
+    // se cuenta en stats.ghost_hits_2x / ghost_hits_4x. Desactivadas solo
+    // cuestan una comprobacion por fallo.
+    void enable_ghosts(bool enabled);
+
+    // Con un filtro, un bloque que falla solo entra si es mas frecuente que la
+    // victima LRU de su conjunto; nullptr lo desactiva
+    void set_admission_filter(TinyLFU* filter);
+
+    // Reparto por vias (como Intel CAT con mascaras disjuntas): el inquilino
+    // no ocupa mas de max_ways vias de cada conjunto; al llegar al limite
+    // desaloja su propio LRU. Si no, desaloja el LRU de un inquilino que
+    // exceda su limite en el conjunto, o el LRU del conjunto. Los aciertos no
+    // dependen del reparto. Hasta MAX_TENANTS inquilinos: false fuera de rango.
+    bool set_way_partition(int tenant, unsigned int max_ways);
+
+    // Reparto por cuota (como el limite de memoria de un cgroup): por encima
+    // de max_blocks en toda la cache, el inquilino desaloja su propio LRU del
+    // conjunto si tiene alguno en el. false si el inquilino esta fuera de rango.
+    bool set_tenant_quota(int tenant, long long max_blocks);
+
+    long long tenant_occupancy(int tenant) const {
+        return tenant >= 0 && tenant < static_cast<int>(occupancy.size()) ? occupancy[tenant] : 0;
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+
+// Funcion de correspondencia bloque -> (conjunto, tag) compartida por las caches.
+//
+// Si el numero de conjuntos es potencia de dos se usa mascara y desplazamiento;
+// en otro caso el modulo y la division se calculan con la reduccion de Lemire
+// (una multiplicacion de 64x64 bits en lugar de una division entera). El caso
+// se elige una sola vez en el constructor y la rama resultante es siempre la
+// misma, por lo que el predictor de saltos la resuelve sin coste.
+//
+// Con XOR_HASH el indice se mezcla con los bits del tag para repartir patrones
+// con paso (stride) multiplo del numero de conjuntos. La mezcla es invertible
+// dado el tag, asi que las caches pueden seguir guardando solo el tag.
+//
+// Los block_id se interpretan como enteros sin signo, por lo que un id negativo
+// nunca produce un indice fuera de rango.
+
+enum IndexHash {
+    NO_HASH,
+    XOR_HASH
+};
+
+class SetIndexer {
+    private:
+        uint32_t sets;
+        bool pow2;
+        uint32_t mask;
+        unsigned int shift;
+        uint64_t magic;  // ceil(2^64 / sets) para la reduccion de Lemire
+        IndexHash hash;
+
+        uint32_t fast_mod(uint32_t x) const {
+            uint64_t low = magic * x;
+            return static_cast<uint32_t>((static_cast<__uint128_t>(low) * sets) >> 64);
+        }
+
+        uint32_t fast_div(uint32_t x) const {
+            return static_cast<uint32_t>((static_cast<__uint128_t>(magic) * x) >> 64);
+        }
+
+    public:
+        SetIndexer(uint32_t num_sets, IndexHash h = NO_HASH)
+            : sets(num_sets), pow2((num_sets & (num_sets - 1)) == 0), mask(num_sets - 1), shift(0), magic(0), hash(h) {
+            if (pow2) {
+                while ((1u << shift) < sets) {
+                    shift++;
+                }
+            } else {
+                magic = UINT64_MAX / sets + 1;
+            }
+        }
+
+        uint32_t tag(int block_id) const {
+            uint32_t x = static_cast<uint32_t>(block_id);
+            return pow2 ? x >> shift : fast_div(x);
+        }
+
+        uint32_t index(int block_id) const {
+            uint32_t x = static_cast<uint32_t>(block_id);
+            if (pow2) {
+                uint32_t set = x & mask;
+                return hash == XOR_HASH ? set ^ ((x >> shift) & mask) : set;
+            }
+            uint32_t set = fast_mod(x);
+            if (hash == XOR_HASH) {
+                // Sin potencia de dos el XOR puede salirse de rango: se usa suma modular
+                set += fast_mod(fast_div(x));
+                if (set >= sets) {
+                    set -= sets;
+                }
+            }
+            return set;
+        }
+
+        IndexHash hashing() const { return hash; }
+
+        // Reconstruye el block_id a partir de su tag y su conjunto
+        int block(uint32_t tag, uint32_t index) const {
+            uint32_t set = index;
+            if (hash == XOR_HASH) {
+                if (pow2) {
+                    set ^= tag & mask;
+                } else {
+                    uint32_t skew = fast_mod(tag);
+                    set = set >= skew ? set - skew : set + sets - skew;
+                }
+            }
+            return static_cast<int>(pow2 ? (tag << shift) | set : tag * sets + set);
+        }
+};
+
+// Familia de funciones hash para caches con un indice distinto por via
+// (skewed-associative, zcache). Cada via usa una semilla distinta sobre el
+// finalizador de MurmurHash3 y el resultado se reduce a [0, sets) con una
+// multiplicacion (sin division).
+inline uint32_t skew_index(int block_id, unsigned int way, uint32_t sets) {
+    static const uint32_t seeds[] = {
+        0x9e3779b9u, 0x7f4a7c15u, 0x85ebca6bu, 0xc2b2ae35u,
+        0x27d4eb2fu, 0x165667b1u, 0xd3a2646cu, 0xfd7046c5u
+    };
+    uint32_t h = static_cast<uint32_t>(block_id) ^ seeds[way % 8];
+    h += way / 8;  // Mas de 8 vias: desplazar la semilla
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return static_cast<uint32_t>((static_cast<uint64_t>(h) * sets) >> 32);
+}
@@ -0,0 +1,72 @@
+#ifndef SHARDEDCACHE
+#define SHARDEDCACHE
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Cache.hpp"
+#include "Stats.hpp"
+
+// Cache asociativa por conjuntos segura para varios hilos.
+// Los conjuntos se reparten entre franjas (stripes), cada una con su propio
+// mutex, de modo que hilos que acceden a conjuntos de franjas distintas no
+// compiten entre si. Las estadisticas se pasan por llamada, asi que cada hilo
+// debe usar su propio AdvancedStats.
+class ShardedCache : public Cache {
+private:
+    struct CacheLine {
+        int block_id;
+        bool valid;
+        bool dirty;
+        unsigned int last_use;  // Marca de tiempo LRU dentro de la franja
+    };
+
+    // Alineada a linea de cache para evitar false sharing entre franjas
+    struct alignas(64) Stripe {
+        std::mutex lock;
+        unsigned int clock = 0;
+        unsigned long long acquisitions = 0;
+        unsigned long long hold_ns = 0;
+    };
+
+    class StripeGuard;
+
+    int num_sets;
+    unsigned int ways;
+    int num_stripes;
+    bool measure_hold;  // Medir el tiempo que se mantiene cada lock
+    std::vector<CacheLine> lines;  // num_sets * ways lineas contiguas
+    std::unique_ptr<Stripe[]> stripes;
+
+    int set_of(int block_id) const;
+    CacheLine* find(int set_index, int block_id);
+
+public:
+    struct LockStats {
+        unsigned long long acquisitions;
+        unsigned long long hold_ns;
+    };
+
+    ShardedCache(int size, int num_ways, int stripes_count = 16, bool measure_lock_hold = false);
+
+    ShardedCache(ShardedCache const &c);
+
+    bool access(int block_id, AdvancedStats& stats) override;
+
+    void add_block(int block_id) override;
+
+    void mark_dirty(int block_id) override;
+
+    // No es seguro con otros hilos accediendo a la cache
+    void reset() override;
+
+    long long dirty_blocks() const override;
+
+    // Suma de adquisiciones y tiempo de retencion de todas las franjas.
+    // Solo es consistente cuando no hay hilos accediendo a la cache.
+    LockStats lock_stats() const;
+
+    void reset_lock_stats();
+};
+
+#endif
@@ -1,8 +1,15 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <chrono>
+#include "AccessPattern.hpp"
+#include "FastRandom.hpp"
+#include "BeladyOracle.hpp"
 #include "FileSystem.hpp"
 #include "Stats.hpp"
+#include "TenantStats.hpp"
+#include "TimeSeries.hpp"
+#include "Workload.hpp"
 #include <tabulate/table.hpp>
 
 enum COLOR {
@@ -15,7 +22,230 @@ enum COLOR {
     CYAN = 36
 };
 
+void initialize_stat(AdvancedStats& stats);
+
+// Suma a `into` la diferencia entre dos estados de las estadisticas
+void accumulate_delta(AdvancedStats& into, const AdvancedStats& before, const AdvancedStats& after);
+
+// Materializa el patron en un vector; para trazas largas usar AccessPattern
 std::vector<int> generate_access_pattern(int num_ops, bool sequential);
-void run_simulation(FileSystem& fs, std::vector<int>& addresses, AdvancedStats& stats);
+
+// Elige lectura o escritura para las fuentes que solo dan direcciones.
+// Cada decision compara los 32 bits altos de un valor aleatorio con
+// write_ratio * 2^32; los valores se generan por bloques de BATCH.
+class OperationMix {
+    private:
+        static const int BATCH = 256;
+        XoshiroBatch gen;
+        uint64_t threshold;
+        uint64_t buffer[BATCH];
+        int buffered;
+
+    public:
+        OperationMix(double ratio)
+            : gen(12345), threshold(static_cast<uint64_t>(ratio * 4294967296.0)), buffered(BATCH) {}
+
+        bool next_is_write() {
+            if (buffered == BATCH) {
+                gen.fill(buffer, BATCH);
+                buffered = 0;
+            }
+            return (buffer[buffered++] >> 32) < threshold;
+        }
+};
+
+// Emite un acceso: una direccion sola usa la mezcla de operaciones, un
+// AccessRecord trae su propia operacion
+inline void issue_access(FileSystem& fs, int address, OperationMix& mix, AdvancedStats& stats) {
+    if (mix.next_is_write()) {
+        fs.write(address, stats);
+    } else {
+        fs.read(address, stats);
+    }
+}
+
+// Un acceso con el inquilino fuera de rango se descarta: ejecutarlo con el
+// inquilino anterior cargaria sus bloques a otro, y TenantStats no lo registra
+inline void issue_access(FileSystem& fs, const AccessRecord& record, OperationMix&, AdvancedStats& stats) {
+    if (!fs.set_tenant(record.tenant)) {
+        return;
+    }
+    if (record.write) {
+        fs.write(record.address, record.size, stats);
+    } else {
+        fs.read(record.address, record.size, stats);
+    }
+}
+
+inline int tenant_of(int) { return 0; }
+inline int tenant_of(const AccessRecord& record) { return record.tenant; }
+
+enum WarmupMode {
+    NO_WARMUP,
+    WARMUP_OPS,           // Las primeras `ops` operaciones
+    WARMUP_TIME,          // Hasta `ms` de tiempo simulado
+    WARMUP_STEADY_STATE   // Hasta que la tasa de aciertos por ventana se estabiliza
+};
+
+// Calentamiento: al terminar se reinician las estadisticas (no la cache). El
+// regimen estacionario se declara cuando las tasas de aciertos de `windows`
+// ventanas consecutivas difieren como mucho en `tolerance`; si no ocurre
+// antes de max_ops (0 = sin limite) se cuenta desde ahi. Si la ejecucion
+// acaba sin terminar el calentamiento, todo cuenta como calentamiento: las
+// estadisticas quedan a cero y warmup_ops es el total de operaciones.
+struct WarmupSpec {
+    WarmupMode mode = NO_WARMUP;
+    long long ops = 0;
+    double ms = 0.0;
+    int windows = 4;
+    double tolerance = 0.01;
+    long long max_ops = 0;
+};
+
+struct RunConfig {
+    double write_ratio = 0.2;       // Solo para fuentes de direcciones sin operacion
+    WarmupSpec warmup;
+    long long window_ops = 1000;    // Ventana de la serie temporal y de la deteccion (0: sin ventanas por operaciones)
+    double window_ms = 0.0;         // Ventana en tiempo simulado (0: sin ventanas por tiempo)
+    TimeSeries* series = nullptr;   // Opcional: una muestra por ventana
+    TenantStats* tenants = nullptr; // Opcional: reparto por inquilino
+};
+
+inline double arrival_of(int) { return 0.0; }
+inline double arrival_of(const AccessRecord& record) { return record.arrival; }
+
+// Ventanas y calentamiento de run_simulation. El bucle solo la consulta
+// cuando el numero de operaciones llega a next_boundary(), o en cada
+// operacion si hay ventanas o calentamiento por tiempo. El tiempo simulado
+// es la llegada del acceso si la fuente la trae o, si no, el tiempo de
+// dispositivo acumulado. Con serie temporal, cada ventana lleva ademas los
+// bloques sucios de la cache al cerrarse y los percentiles de la latencia
+// por operacion (el tiempo de dispositivo que provoca).
+class RunMonitor {
+    private:
+        RunConfig config;
+        const FileSystem& fs;
+        AdvancedStats window_start;
+        long long window_first_op;
+        double window_start_time;
+        long long boundary;
+        bool warming;
+        double device_before_reset;  // Tiempo de dispositivo descartado con el calentamiento
+        double time;
+        std::vector<double> recent;  // Tasas de aciertos de las ultimas ventanas
+        LatencyHistogram latency;    // Latencias de la ventana en curso
+
+        void close_window(long long ops, AdvancedStats& stats);
+        void end_warmup(long long ops, AdvancedStats& stats);
+
+    public:
+        RunMonitor(const RunConfig& cfg, const FileSystem& fs);
+
+        long long next_boundary() const { return boundary; }
+        bool warming_up() const { return warming; }
+        bool per_op() const { return config.window_ms > 0.0 || (warming && config.warmup.mode == WARMUP_TIME); }
+        bool tracks_latency() const { return config.series != nullptr; }
+
+        void record_latency(double ms) { latency.record(ms); }
+
+        // Tras la operacion numero `ops`, que llego en `arrival`; devuelve la siguiente frontera
+        long long advance(long long ops, double arrival, AdvancedStats& stats);
+
+        // Cierra la ultima ventana, aunque este incompleta, y termina el
+        // calentamiento si sigue en curso
+        void finish(long long ops, AdvancedStats& stats);
+};
+
+// Función de simulación sobre cualquier rango de entrada de direcciones (int)
+// o de AccessRecord: contenedores, AccessPattern, Workload o cualquier
+// generador envuelto en PullIterator. Solo se recorre una vez, asi que la
+// memoria es constante si la fuente es perezosa. `config` anade el
+// calentamiento, la serie temporal por ventanas y el reparto por inquilinos;
+// las estadisticas y los tiempos solo cuentan lo posterior al calentamiento.
+template <typename Accesses>
+void run_simulation(FileSystem& fs, Accesses&& accesses, AdvancedStats& stats, const RunConfig& config) {
+
+    initialize_stat(stats);
+    OperationMix mix(config.write_ratio);
+    TenantStats* tenants = config.tenants;
+    if (tenants) {
+        tenants->clear();
+    }
+    RunMonitor monitor(config, fs);
+    bool track_latency = monitor.tracks_latency();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    long long ops = 0;
+    long long measured_from = 0;
+    long long boundary = monitor.next_boundary();
+    AdvancedStats before;
+    for (auto&& access : accesses) {
+        // La latencia de cada acceso es el tiempo de dispositivo que provoca
+        double device_before = stats.device_time;
+        if (!tenants) {
+            issue_access(fs, access, mix, stats);
+        } else {
+            before = stats;
+            issue_access(fs, access, mix, stats);
+            tenants->add(tenant_of(access), before, stats);
+            tenants->record_latency(tenant_of(access), stats.device_time - device_before);
+        }
+        if (track_latency) {
+            monitor.record_latency(stats.device_time - device_before);
+        }
+        ops++;
+        if (ops == boundary || monitor.per_op()) {
+            bool was_warming = monitor.warming_up();
+            boundary = monitor.advance(ops, arrival_of(access), stats);
+            if (was_warming && !monitor.warming_up()) {
+                start = std::chrono::high_resolution_clock::now();
+                measured_from = ops;
+            }
+        }
+    }
+    fs.sync(stats);
+    bool was_warming = monitor.warming_up();
+    monitor.finish(ops, stats);
+    if (was_warming) {
+        start = std::chrono::high_resolution_clock::now();
+        measured_from = ops;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    ops -= measured_from;
+    stats.total_latency = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    stats.avg_access_time = ops > 0 ? stats.total_latency / ops : 0.0;
+}
+
+// Sin calentamiento ni ventanas. En las fuentes de solo direcciones,
+// write_ratio es la fraccion de escrituras. Con `tenants` se reparten ademas
+// las estadisticas entre los inquilinos de los accesos.
+template <typename Accesses>
+void run_simulation(FileSystem& fs, Accesses&& accesses, AdvancedStats& stats, double write_ratio = 0.2,
+                    TenantStats* tenants = nullptr) {
+    RunConfig config;
+    config.write_ratio = write_ratio;
+    config.window_ops = 0;
+    config.tenants = tenants;
+    run_simulation(fs, accesses, stats, config);
+}
+
+// Cota optima (Belady) para una cache de `capacity` bloques: fs debe estar
+// construido sobre `recorder`, que se vacia antes de registrar la traza.
+template <typename Accesses>
+void run_optimal(FileSystem& fs, TraceRecorder& recorder, Accesses&& accesses, int capacity, AdvancedStats& stats) {
+    recorder.clear();
+    run_simulation(fs, accesses, stats);
+
+    // Solo se conservan aciertos y fallos: el resto corresponde a la grabacion
+    initialize_stat(stats);
+    BeladyOracle(capacity).run(recorder.trace(), stats);
+}
+
+std::string hit_rate(const AdvancedStats& stats);
 void print_stats(const AdvancedStats& stats, const std::string& fs_name, COLOR c = DEFAULT);
-tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const AdvancedStats& stats_ext4, std::string& name);
+tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const AdvancedStats& stats_ext4, std::string& name,
+                                  const AdvancedStats* opt_ext3 = nullptr, const AdvancedStats* opt_ext4 = nullptr);
+tabulate::Table print_tenant_table(const TenantStats& tenants, std::string& name);
+tabulate::Table print_time_series_table(const TimeSeries& series, std::string& name);
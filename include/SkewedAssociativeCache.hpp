@@ -0,0 +1,58 @@
+#ifndef SKEWEDASSOCIATIVECACHE
+#define SKEWEDASSOCIATIVECACHE
+
+#include <cstdint>
+#include <vector>
+#include "Cache.hpp"
+#include "Stats.hpp"
+
+// Cache asociativa sesgada (skewed-associative).
+// Cada via es un banco de capacity / ways lineas indexado con una funcion hash
+// distinta, de modo que dos bloques que chocan en una via casi nunca chocan en
+// las demas. Como el hash no es invertible se guarda el block_id completo.
+// El reemplazo es LRU aproximado por marcas de tiempo entre los candidatos.
+class SkewedAssociativeCache : public Cache {
+protected:
+    static constexpr uint32_t DIRTY = 1;
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    struct CacheLine {
+        uint32_t entry;     // (block_id << 1) | dirty, o EMPTY; block_id en rango (Cache::in_range)
+        uint32_t last_use;  // Marca de tiempo del ultimo acceso
+    };
+
+    int num_sets;        // Lineas por via
+    unsigned int ways;
+    uint32_t clock;
+    std::vector<CacheLine> lines;  // Via w ocupa [w * num_sets, (w + 1) * num_sets)
+
+    CacheLine& line(int block_id, unsigned int way);
+    CacheLine* find(int block_id);
+
+    // Antiguedad de una linea; las vacias son siempre las mejores victimas
+    uint32_t age(const CacheLine& l) const {
+        return l.entry == EMPTY ? UINT32_MAX : clock - l.last_use;
+    }
+
+public:
+    SkewedAssociativeCache(int size, int num_ways);
+
+    SkewedAssociativeCache(SkewedAssociativeCache const &c);
+
+    bool access(int block_id, AdvancedStats& stats) override;
+
+    void add_block(int block_id) override;
+
+    void mark_dirty(int block_id) override;
+
+    void reset() override;
+
+
+    long long dirty_blocks() const override;
+
+    void save(SnapshotWriter& out) const override;
+
+    bool load(SnapshotReader& in) override;
+};
+
+#endif
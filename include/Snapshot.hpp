@@ -0,0 +1,115 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Instantanea binaria del estado del simulador. El formato es una cabecera
+// (firma y version) seguida de secciones; cada seccion empieza con una
+// etiqueta de 4 bytes que identifica al objeto que la escribio, y los
+// vectores se guardan como longitud + bytes en crudo alineados a 8. Usa el
+// orden de bytes de la maquina: no es portable entre arquitecturas.
+class SnapshotWriter {
+    private:
+        std::vector<char> buffer;
+
+        void pad();
+
+    public:
+        SnapshotWriter();
+
+        template <typename T>
+        void put(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "solo tipos copiables byte a byte");
+            const char* bytes = reinterpret_cast<const char*>(&value);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void put_vector(const std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable<T>::value, "solo tipos copiables byte a byte");
+            put<uint64_t>(values.size());
+            pad();
+            const char* bytes = reinterpret_cast<const char*>(values.data());
+            buffer.insert(buffer.end(), bytes, bytes + values.size() * sizeof(T));
+            pad();
+        }
+
+        // Etiqueta de seccion, p. ej. tag("SAC1")
+        void tag(const char (&name)[5]) { put<uint32_t>(code(name)); }
+
+        static uint32_t code(const char (&name)[5]) {
+            uint32_t c;
+            std::memcpy(&c, name, 4);
+            return c;
+        }
+
+        size_t size() const { return buffer.size(); }
+
+        // Escribe la instantanea completa; false si falla la escritura
+        bool write_file(const std::string& path) const;
+};
+
+// Lee una instantanea proyectando el fichero en memoria con mmap: no hay
+// lecturas intermedias y cada vector se restaura con una sola copia desde la
+// pagina proyectada. Cualquier lectura fuera de rango o etiqueta inesperada
+// deja el lector en estado de error (ok() == false) y las lecturas
+// siguientes no hacen nada.
+class SnapshotReader {
+    private:
+        const char* data;
+        size_t length;
+        size_t offset;
+        bool valid;
+
+        void pad();
+        bool take(void* out, size_t n);
+
+    public:
+        explicit SnapshotReader(const std::string& path);
+        ~SnapshotReader();
+
+        SnapshotReader(const SnapshotReader&) = delete;
+        SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+        template <typename T>
+        bool get(T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "solo tipos copiables byte a byte");
+            return take(&value, sizeof(T));
+        }
+
+        template <typename T>
+        bool get_vector(std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable<T>::value, "solo tipos copiables byte a byte");
+            uint64_t n = 0;
+            if (!get(n)) {
+                return false;
+            }
+            pad();
+            if (!valid || n > (length - offset) / sizeof(T)) {
+                valid = false;
+                return false;
+            }
+            values.resize(n);
+            take(values.data(), n * sizeof(T));
+            pad();
+            return valid;
+        }
+
+        // Comprueba la etiqueta de la seccion siguiente
+        bool expect(const char (&name)[5]);
+
+        // Comprueba que un valor guardado coincide con el esperado (geometria)
+        template <typename T>
+        bool expect_value(const T& expected) {
+            T stored;
+            if (get(stored) && !(stored == expected)) {
+                valid = false;
+            }
+            return valid;
+        }
+
+        bool ok() const { return valid; }
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "BlockDevice.hpp"
+
+struct SSDGeometry {
+    int channels = 4;
+    int dies_per_channel = 2;
+    int blocks_per_die = 128;      // Bloques de borrado por die
+    int pages_per_block = 64;      // Pagina = bloque de 4KB del sistema de archivos
+    double overprovisioning = 0.125;
+    int gc_threshold = 2;          // Bloques libres por die por debajo de los que se recolecta
+    double read_ms = 0.05;
+    double program_ms = 0.5;
+    double erase_ms = 3.0;
+    double transfer_ms = 0.01;     // Una pagina por el bus del canal
+};
+
+// SSD con FTL de mapeo por pagina. Las escrituras van a la siguiente pagina
+// libre del bloque activo de cada die, repartidas en turno entre los dies; la
+// pagina anterior queda invalida. Cuando un die se queda sin bloques libres
+// la recoleccion elige el bloque con menos paginas validas, las copia dentro
+// del die y lo borra. Cada die y cada canal llevan su propio instante de
+// ocupacion, de modo que las paginas de una peticion se solapan entre dies.
+// nand_writes cuenta las paginas programadas (anfitrion + recoleccion) y
+// block_erases los borrados.
+class SolidStateDrive : public BlockDevice {
+    private:
+        enum BlockState : uint8_t { FREE, ACTIVE, FULL };
+
+        struct Die {
+            std::vector<int> free_blocks;
+            int active_block;
+            int write_pointer;
+            double busy_until;
+        };
+
+        static constexpr uint32_t UNMAPPED = UINT32_MAX;
+
+        SSDGeometry geometry;
+        int num_dies;
+        uint32_t logical_pages;
+        std::vector<uint32_t> l2p;        // Pagina logica -> fisica
+        std::vector<uint32_t> p2l;        // Pagina fisica -> logica, para la recoleccion
+        std::vector<int> valid_pages;     // Por bloque de borrado (indice global)
+        std::vector<BlockState> state;
+        std::vector<Die> dies;
+        std::vector<double> channel_busy;
+        int next_die;
+        bool collecting;
+
+        int global_block(int die, int block) const { return die * geometry.blocks_per_die + block; }
+        int die_of(uint32_t ppn) const { return ppn / (geometry.pages_per_block * geometry.blocks_per_die); }
+
+        // El ultimo bloque libre de cada die queda para las copias de la
+        // recoleccion: asi siempre puede vaciar un bloque con alguna pagina
+        // invalida, y un die sin hueco tiene todos sus bloques llenos de
+        // paginas validas, lo que el limite del espacio logico impide en todos
+        // los dies a la vez
+        bool has_room(int die) const {
+            return dies[die].write_pointer < geometry.pages_per_block || dies[die].free_blocks.size() > 1;
+        }
+
+        uint32_t allocate_page(int die, AdvancedStats& stats);
+        void collect(int die, AdvancedStats& stats);
+        double write_page(uint32_t lpn, double now, AdvancedStats& stats);
+        double read_page(uint32_t lpn, double now);
+
+    public:
+        SolidStateDrive(const SSDGeometry& geo = SSDGeometry());
+
+        double service(const DiskRequest& request, double now, AdvancedStats& stats) override;
+
+        // Cada die y cada canal llevan su propia ocupacion
+        double start_time(double now) const override { return now; }
+
+        uint32_t capacity_pages() const { return logical_pages; }
+};
@@ -1,11 +1,30 @@
 #pragma once
 
 struct AdvancedStats {
-    int cache_hits;
-    int cache_misses;
-    int disk_reads;
-    int disk_writes;
-    int journal_ops;
+    long long cache_hits;
+    long long cache_misses;
+    long long disk_reads;     // Bloques leidos de disco
+    long long disk_writes;    // Bloques escritos a disco
+    long long read_iops;      // Peticiones de lectura (un tramo contiguo cada una)
+    long long write_iops;     // Peticiones de escritura
+    long long bytes_read;
+    long long bytes_written;
+    long long journal_ops;
+    long long merged_requests;  // Peticiones fusionadas en la cola del planificador
+    long long issued_requests;  // Peticiones que llegan al dispositivo
+    long long nand_writes;      // Paginas programadas en el SSD, incluida la recoleccion
+    long long block_erases;
+    long long ghost_hits_2x;  // Fallos que habrian acertado con el doble de capacidad
+    long long ghost_hits_4x;  // Fallos que habrian acertado con el cuadruple (incluye los de 2x)
     double total_latency;
     double avg_access_time;
-};
\ No newline at end of file
+    double device_time;         // Tiempo de servicio del dispositivo (ms)
+    double simulated_time;      // Duracion en tiempo simulado (ms), solo en TimedSimulation
+    double op_latency;          // Suma de latencias simuladas por operacion (ms)
+    long long completed_ops;
+    long long warmup_ops;       // Operaciones descartadas por el calentamiento
+};
+
+// Inquilinos validos: 0 .. MAX_TENANTS - 1 (las caches con particionado
+// guardan el propietario de cada entrada en un byte)
+const int MAX_TENANTS = 256;
\ No newline at end of file
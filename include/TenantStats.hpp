@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Stats.hpp"
+
+// Histograma de latencias con precision relativa fija (estilo HdrHistogram):
+// los valores, en microsegundos, por debajo de 64 tienen cubeta propia y por
+// encima cada potencia de dos se divide en 32 cubetas, con un error maximo
+// del 3 %. Tamano fijo e independiente del numero de muestras.
+class LatencyHistogram {
+    private:
+        static const int SUB_BUCKETS = 32;
+        static const int BUCKETS = 2 * SUB_BUCKETS + 40 * SUB_BUCKETS;
+
+        std::vector<uint64_t> counts;
+        uint64_t total;
+        double sum_ms;
+        double max_ms;
+
+        static int bucket_of(uint64_t us);
+        static double lower_bound_ms(int bucket);
+
+    public:
+        LatencyHistogram();
+
+        void record(double ms);
+
+        // Latencia (ms) por debajo de la que queda la fraccion p de las
+        // muestras: el limite superior de su cubeta (como el valor equivalente
+        // mas alto de HdrHistogram), acotado por el maximo registrado. Asi el
+        // percentil nunca se queda corto; puede pasarse hasta un 3 %
+        double percentile(double p) const;
+
+        uint64_t count() const { return total; }
+        double mean() const { return total > 0 ? sum_ms / total : 0.0; }
+        double max() const { return max_ms; }
+
+        void clear();
+};
+
+// Estadisticas por inquilino: contadores de AdvancedStats atribuidos a cada
+// uno (la diferencia de las estadisticas globales alrededor de cada acceso) y
+// un histograma de latencias por operacion.
+class TenantStats {
+    private:
+        std::vector<AdvancedStats> per_tenant;
+        std::vector<LatencyHistogram> latency;
+
+        void ensure(int tenant);
+
+    public:
+        // Suma a `tenant` lo que cambio de `before` a `after`. Las dos
+        // devuelven false, sin registrar nada, fuera de 0..MAX_TENANTS-1
+        bool add(int tenant, const AdvancedStats& before, const AdvancedStats& after);
+
+        bool record_latency(int tenant, double ms);
+
+        int tenants() const { return per_tenant.size(); }
+        const AdvancedStats& of(int tenant) const { return per_tenant[tenant]; }
+        const LatencyHistogram& latency_of(int tenant) const { return latency[tenant]; }
+
+        void clear();
+};
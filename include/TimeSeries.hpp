@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Stats.hpp"
+
+class MetricsWriter;
+
+// Estadisticas de una ventana de la simulacion: lo que cambio en
+// AdvancedStats entre su primera y su ultima operacion, mas el estado de la
+// cache al cerrarla
+struct WindowSample {
+    long long first_op;  // Indice de la primera operacion (desde el inicio, calentamiento incluido)
+    long long ops;
+    double time;         // Tiempo simulado al cerrar la ventana (ms)
+    bool warmup;         // La ventana pertenece al calentamiento
+    long long dirty_blocks;   // Bloques sucios en la cache al cerrar la ventana
+    long long cache_blocks;   // Capacidad de la cache
+    double latency_p50;       // Percentiles de la latencia por operacion (ms)
+    double latency_p99;
+    double latency_p999;
+    AdvancedStats delta;
+};
+
+// Serie temporal por ventanas de una ejecucion. Guarda las ultimas
+// `capacity` ventanas en un anillo de memoria fija (las mas antiguas se
+// sobrescriben) y, si tiene un MetricsWriter, le pasa cada ventana al
+// cerrarse para no perder ninguna.
+class TimeSeries {
+    private:
+        std::vector<WindowSample> ring;
+        size_t head;       // Posicion de la ventana mas antigua
+        size_t count;
+        long long total;   // Ventanas recibidas desde el ultimo clear()
+        MetricsWriter* writer;
+
+    public:
+        explicit TimeSeries(size_t capacity = 1024);
+
+        void add(const WindowSample& sample);
+
+        // Vuelca al escritor lo que tenga pendiente
+        void flush();
+
+        void clear();
+
+        void set_writer(MetricsWriter* w) { writer = w; }
+
+        // Ventanas retenidas; [0] es la mas antigua
+        size_t size() const { return count; }
+        const WindowSample& operator[](size_t i) const { return ring[(head + i) % ring.size()]; }
+
+        // Ventanas que ya no estan en el anillo
+        long long dropped() const { return total - static_cast<long long>(count); }
+};
@@ -0,0 +1,174 @@
+#pragma once
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "BlockDevice.hpp"
+#include "EventQueue.hpp"
+#include "IOScheduler.hpp"
+#include "Simulator.hpp"
+
+struct TimingConfig {
+    int clients = 1;
+    int queue_depth = 1;             // Operaciones en vuelo por cliente
+    double hit_latency_ms = 0.001;   // Coste de una operacion servida desde la cache
+    double journal_commit_ms = 5.0;  // Periodo de commit del journal (0: sin commits)
+    double writeback_ms = 30.0;      // Periodo de la escritura diferida (0: escritura sincrona)
+    int max_request_blocks = 128;    // Tamano maximo al agrupar escrituras diferidas
+    double write_ratio = 0.2;        // Solo para fuentes de direcciones sin operacion
+};
+
+// Simulacion por sucesos en tiempo simulado. Cada cliente mantiene
+// queue_depth operaciones en vuelo: al completarse una se emite la siguiente
+// de la fuente (no antes de su `arrival` si es un AccessRecord). El sistema de
+// archivos se ejecuta igual que en run_simulation, pero sus peticiones pasan
+// por esta clase: las lecturas van al dispositivo en el instante actual y la
+// operacion termina cuando acaba la ultima; las escrituras se acumulan y las
+// emite la escritura diferida periodica, y los bloques de journal se escriben
+// en cada commit. Asi se solapan aciertos, lecturas en curso, commits y
+// escritura diferida sobre el mismo dispositivo.
+//
+// Con set_scheduler las peticiones no van directas al dispositivo: se encolan
+// en el IOScheduler y se despacha la que elija su politica cada vez que el
+// dispositivo queda libre (suceso DEVICE_FREE). Una operacion termina cuando
+// se ha atendido la ultima de sus peticiones, de modo que con mas
+// profundidad de cola el planificador tiene mas donde elegir.
+//
+// Los sucesos no llevan punteros a funcion: el tipo decide el manejador en un
+// switch, lo que mantiene cada suceso en 24 bytes.
+class TimedSimulation : public RequestSink {
+    protected:
+        // Las clases derivadas numeran sus sucesos a partir de FIRST_CUSTOM_EVENT
+        enum EventType : uint32_t { START, DONE, JOURNAL_COMMIT, WRITEBACK, DEVICE_FREE, FIRST_CUSTOM_EVENT };
+
+        FileSystem& fs;
+        BlockDevice& device;
+        TimingConfig config;
+        EventQueue events;
+        OperationMix mix;
+        RequestSink* previous_sink;      // Destino del sistema de archivos fuera de run()
+
+        std::vector<double> op_start;    // Por hueco (cliente x profundidad)
+        std::vector<DiskRequest> dirty;  // Escrituras pendientes de la escritura diferida
+        long long journal_committed;
+        double op_done;                  // Fin de la operacion en curso
+        int in_flight;                   // Huecos ocupados; sin ellos no se reprograman los periodicos
+
+        TenantStats* tenants;            // Opcional: reparto por inquilino
+        std::vector<int> slot_tenant;
+        AdvancedStats before;
+
+        // Operacion esperando a sus peticiones encoladas en el planificador;
+        // se indexa por el dato de su suceso de fin (hueco o cliente)
+        struct Waiter {
+            double done;     // Fin de lo ya atendido
+            int pending;     // Peticiones sin atender
+            bool finished;   // Ya no emite mas peticiones
+            uint32_t type;   // Suceso a emitir al terminar
+        };
+
+        // Peticion sincrona en el planificador, por su numero de llegada
+        struct QueuedRequest {
+            long long id;
+            uint32_t waiter;
+        };
+
+        IOScheduler* scheduler;          // Opcional: cola del dispositivo
+        std::vector<Waiter> waiters;
+        std::vector<QueuedRequest> queued;  // Ordenadas por id
+        std::vector<long long> merged;     // Ids de la ultima peticion despachada
+        uint32_t current;                // Operacion en curso
+        bool wakeup_pending;             // Hay un DEVICE_FREE programado
+
+        void begin_run(AdvancedStats& stats);
+        void end_run(AdvancedStats& stats);
+        void begin_op(uint32_t waiter);
+        void end_op(uint32_t slot, AdvancedStats& stats);
+        // Emite `type` con `data` cuando terminan la operacion en curso y sus peticiones
+        void finish_op(uint32_t type, uint32_t data, AdvancedStats& stats);
+        void kick(AdvancedStats& stats);
+        void resolve(double done);
+        void send(const DiskRequest& request, AdvancedStats& stats);
+        void complete_op(uint32_t slot, AdvancedStats& stats);
+        void periodic(const Event& ev, AdvancedStats& stats);
+        void commit_journal(AdvancedStats& stats);
+        void write_back(AdvancedStats& stats);
+
+
+        template <typename Access>
+        void start_op(uint32_t slot, const Access& access, AdvancedStats& stats) {
+            if (tenants) {
+                before = stats;
+            }
+            begin_op(slot);
+            issue_access(fs, access, mix, stats);
+            end_op(slot, stats);
+            if (tenants) {
+                slot_tenant[slot] = tenant_of(access);
+                tenants->add(slot_tenant[slot], before, stats);
+            }
+        }
+
+    public:
+        TimedSimulation(FileSystem& fs, BlockDevice& device, const TimingConfig& cfg = TimingConfig());
+
+        // Destino de las peticiones del sistema de archivos durante run()
+        void submit(const DiskRequest& request, AdvancedStats& stats) override;
+        void flush(AdvancedStats&) override {}
+
+        int slots() const { return config.clients * config.queue_depth; }
+
+        // Estadisticas y percentiles de latencia por inquilino en cada run()
+        void set_tenant_stats(TenantStats* stats) { tenants = stats; }
+
+        // Cola con politica entre el sistema de archivos y el dispositivo
+        // (nullptr: orden de llegada). Se usa con enqueue/take, sin su destino
+        void set_scheduler(IOScheduler* s) { scheduler = s; }
+
+        template <typename Accesses>
+        void run(Accesses&& accesses, AdvancedStats& stats) {
+            using Access = typename std::decay<decltype(*std::begin(accesses))>::type;
+            std::vector<Access> waiting(slots());
+
+            begin_run(stats);
+            auto it = std::begin(accesses);
+            auto last = std::end(accesses);
+
+            // Ocupa el hueco con el siguiente acceso; empieza ya si ha llegado
+            auto next_into = [&](uint32_t slot) {
+                if (it == last) {
+                    return;
+                }
+                waiting[slot] = *it;
+                ++it;
+                in_flight++;
+                double arrival = arrival_of(waiting[slot]);
+                if (arrival > events.now()) {
+                    events.push(arrival, START, slot);
+                } else {
+                    start_op(slot, waiting[slot], stats);
+                }
+            };
+
+            for (int slot = 0; slot < slots(); ++slot) {
+                next_into(slot);
+            }
+
+            Event ev;
+            while (events.pop(ev)) {
+                switch (ev.type) {
+                    case START:
+                        start_op(ev.data, waiting[ev.data], stats);
+                        break;
+                    case DONE:
+                        complete_op(ev.data, stats);
+                        next_into(ev.data);
+                        break;
+                    default:
+                        periodic(ev, stats);
+                        break;
+                }
+            }
+            end_run(stats);
+        }
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+// Filtro de admision TinyLFU.
+// Estima la frecuencia reciente de cada bloque con un Count-Min sketch de
+// contadores de 4 bits precedido por un doorkeeper (filtro de Bloom) que
+// absorbe los bloques vistos una sola vez. Los 4 contadores de un bloque
+// (uno por fila) estan en la misma palabra de 64 bits: la palabra se divide
+// en 4 grupos de 4 contadores y cada fila elige uno de su grupo, de modo que
+// registrar o estimar toca una sola linea de cache.
+// Cada `sample_size` registros todos los contadores se dividen a la mitad y
+// el doorkeeper se vacia, asi la frecuencia refleja el pasado reciente.
+//
+// El sketch ocupa 8 bytes por bloque de la cache y el doorkeeper 1 byte, por
+// lo que para caches de miles de bloques cabe entero en L1/L2.
+class TinyLFU {
+    private:
+        std::vector<uint64_t> table;       // 16 contadores de 4 bits por palabra
+        std::vector<uint64_t> doorkeeper;  // Bits del filtro de Bloom
+        uint64_t word_mask;
+        uint32_t door_mask;
+        int additions;
+        int sample_size;
+
+        static uint64_t hash(int block_id) {
+            // splitmix64
+            uint64_t z = static_cast<uint32_t>(block_id) + 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        // Contador (0-15) de la palabra que corresponde a una fila
+        static unsigned int nibble(uint64_t h, unsigned int row) {
+            return (row << 2) | ((h >> (48 + 2 * row)) & 3);
+        }
+
+        bool door_contains(uint64_t h) const {
+            uint32_t a = h & door_mask;
+            uint32_t b = (h >> 32) & door_mask;
+            return ((doorkeeper[a >> 6] >> (a & 63)) & 1) && ((doorkeeper[b >> 6] >> (b & 63)) & 1);
+        }
+
+        void door_add(uint64_t h);
+        void age();
+
+    public:
+        TinyLFU(int capacity);
+
+        // Registrar un acceso (acierto o fallo) al bloque
+        void record(int block_id);
+
+        // Frecuencia estimada, entre 0 y 16
+        int estimate(int block_id) const {
+            uint64_t h = hash(block_id);
+            uint64_t word = table[(h >> 8) & word_mask];
+            int frequency = 15;
+            for (unsigned int row = 0; row < 4; ++row) {
+                int count = (word >> (nibble(h, row) << 2)) & 0xf;
+                frequency = count < frequency ? count : frequency;
+            }
+            return frequency + (door_contains(h) ? 1 : 0);
+        }
+
+        // Un bloque que falla solo puede desalojar a la victima si es mas frecuente
+        bool admit(int candidate, int victim) const {
+            return estimate(candidate) > estimate(victim);
+        }
+
+        void reset();
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "FastRandom.hpp"
+#include "PullIterator.hpp"
+#include "Stats.hpp"
+
+// Un acceso de la carga de trabajo
+struct AccessRecord {
+    int address;     // Desplazamiento en bytes
+    int size;        // Tamano de la peticion en bytes
+    bool write;
+    double arrival;  // Instante de llegada en ms de tiempo simulado
+    int tenant;      // Inquilino (servicio o cgroup) que emite el acceso
+};
+
+enum KeyDistribution {
+    UNIFORM,
+    ZIPF,
+    SCRAMBLED_ZIPF,  // Zipf con los rangos dispersados por hash (sin localidad espacial)
+    HOTSPOT,         // hot_fraction de los bloques recibe hot_probability de los accesos
+    LATEST,          // Zipf sobre los bloques escritos mas recientemente
+    SEQUENTIAL       // Recorrido con paso `stride`
+};
+
+enum ArrivalProcess {
+    CLOSED_LOOP,  // Sin tiempos entre llegadas (arrival = 0)
+    POISSON,      // Llegadas exponenciales con tasa `rate`
+    ON_OFF        // Rafagas de Poisson de duracion media on_ms separadas por off_ms de silencio
+};
+
+// Distribucion de bloques de una componente de una fase
+struct KeySpec {
+    KeyDistribution distribution = UNIFORM;
+    double weight = 1.0;         // Peso relativo dentro de la fase (fases mixtas)
+    int num_blocks = 1 << 12;    // Tamano del espacio de bloques
+    double zipf_theta = 0.99;
+    double hot_fraction = 0.2;
+    double hot_probability = 0.8;
+    int stride = 1;
+    long long drift_every = 0;   // Cada cuantas operaciones se desplaza el conjunto caliente (0 = fijo)
+    int drift_step = 0;          // Bloques que se desplaza en cada deriva
+    int first_block = 0;         // Los bloques van de first_block a first_block + num_blocks - 1
+    int tenant = 0;              // Inquilino al que se atribuyen los accesos (0..MAX_TENANTS-1)
+};
+
+struct PhaseSpec {
+    long long ops = 10000;
+    std::vector<KeySpec> keys = {KeySpec()};
+    double write_ratio = 0.2;
+    int min_size = 0;            // Bytes; 0 = un bloque
+    int max_size = 0;
+    ArrivalProcess arrivals = CLOSED_LOOP;
+    double rate = 1.0;           // Peticiones por ms
+    double on_ms = 10.0;
+    double off_ms = 10.0;
+};
+
+// Generador Zipf (Gray et al., el mismo que usa YCSB): tras precalcular zeta(n)
+// cada muestra cuesta una potencia, sin tablas de tamano n. Con theta = 1
+// alpha = 1/(1-theta) no es finito y se usa el limite de la formula,
+// n * exp(-eta * (1-u)).
+class ZipfGenerator {
+    private:
+        int items;
+        double theta;
+        double zetan;
+        double alpha;
+        double eta;
+        bool harmonic;  // theta = 1
+
+    public:
+        ZipfGenerator(int n = 1, double theta = 0.99);
+
+        // Rango en [0, n), 0 es el mas popular
+        int next(double u) const;
+};
+
+// Generador de carga compuesto por fases que se ejecutan una tras otra.
+// Los accesos se producen bajo demanda con next() o recorriendolo como rango
+// (begin() reinicia), sin materializar la traza, y la secuencia depende solo
+// de la semilla. Las direcciones son desplazamientos int: los bloques que no
+// caben por debajo de 2^31 bytes se pliegan modulo el numero que si cabe.
+class Workload {
+    private:
+        struct Component {
+            KeySpec spec;
+            ZipfGenerator zipf;
+            long long position;  // Recorrido secuencial
+        };
+
+        int block_size;
+        uint64_t seed;
+        std::vector<PhaseSpec> phases;
+
+        Xoshiro256pp gen;
+        size_t phase;
+        long long phase_op;
+        std::vector<Component> components;
+        double total_weight;
+        double clock;
+        double burst_end;   // ON_OFF: fin de la rafaga actual
+        int latest;         // LATEST: ultimo bloque escrito
+
+        void start_phase();
+        int next_block(Component& c, bool write);
+        double next_arrival(const PhaseSpec& p);
+
+    public:
+        Workload(int block_size, uint64_t seed = 10);
+
+        // false (y la fase no se anade) si no tiene componentes o alguna
+        // tiene num_blocks < 1 o un inquilino fuera de 0..MAX_TENANTS-1
+        bool add_phase(const PhaseSpec& phase);
+
+        // Devuelve false cuando se han agotado todas las fases
+        bool next(AccessRecord& record);
+
+        // Vuelve al principio con la misma semilla
+        void rewind();
+
+        long long total_ops() const;
+
+        PullIterator<Workload, AccessRecord> begin() {
+            rewind();
+            return PullIterator<Workload, AccessRecord>(*this);
+        }
+
+        PullIterator<Workload, AccessRecord> end() { return PullIterator<Workload, AccessRecord>(); }
+};
@@ -0,0 +1,35 @@
+#ifndef ZCACHE
+#define ZCACHE
+
+#include <vector>
+#include "SkewedAssociativeCache.hpp"
+
+// ZCache: cache sesgada con reubicacion estilo cuckoo.
+// Las busquedas cuestan lo mismo que en SkewedAssociativeCache (una linea por
+// via), pero en cada fallo se recorre en anchura el arbol de reubicaciones:
+// los bloques de las posiciones candidatas podrian moverse a su posicion en
+// otra via, liberando su linea. Con `levels` niveles se evaluan hasta
+// ways * (ways - 1)^(levels - 1) candidatos y se desaloja el mas antiguo,
+// desplazando los bloques del camino hasta la raiz.
+class ZCache : public SkewedAssociativeCache {
+private:
+    struct Candidate {
+        uint32_t pos;        // Indice en lines
+        unsigned int way;
+        int parent;          // Candidato cuyo bloque se moveria aqui, -1 en la raiz
+    };
+
+    int levels;
+    std::vector<Candidate> candidates;  // Reutilizado entre fallos para no reservar memoria
+
+    bool on_path(int candidate, uint32_t pos) const;
+
+public:
+    ZCache(int size, int num_ways, int walk_levels = 2);
+
+    ZCache(ZCache const &c);
+
+    void add_block(int block_id) override;
+};
+
+#endif
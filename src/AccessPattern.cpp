@@ -0,0 +1,29 @@
+#include "AccessPattern.hpp"
+
+AccessPattern::AccessPattern(long long n, bool seq) : num_ops(n), sequential(seq) {
+    rewind();
+}
+
+void AccessPattern::rewind() {
+    produced = 0;
+    gen.seed(10);
+    buffered = BATCH;
+}
+
+bool AccessPattern::next(int& address) {
+    if (produced >= num_ops) {
+        return false;
+    }
+    if (sequential) {
+        // Bloques de 4K; la direccion vuelve a 0 al superar el rango de int
+        address = static_cast<int>((produced * 4096) & 0x7fffffff);
+    } else {
+        if (buffered == BATCH) {
+            gen.fill_bounded(buffer, BATCH, (1 << 24) + 1);
+            buffered = 0;
+        }
+        address = buffer[buffered++];
+    }
+    produced++;
+    return true;
+}
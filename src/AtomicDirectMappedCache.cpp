@@ -0,0 +1,61 @@
+#include "AtomicDirectMappedCache.hpp"
+
+AtomicDirectMappedCache::AtomicDirectMappedCache(int size) : Cache(size) {
+    cache_entries.reset(new std::atomic<uint64_t>[capacity]);
+    for (unsigned int i = 0; i < capacity; ++i) {
+        cache_entries[i].store(0, std::memory_order_relaxed);  // Todas invalidas
+    }
+}
+
+AtomicDirectMappedCache::AtomicDirectMappedCache(AtomicDirectMappedCache const &c) : Cache(c) {
+    cache_entries.reset(new std::atomic<uint64_t>[capacity]);
+    for (unsigned int i = 0; i < capacity; ++i) {
+        cache_entries[i].store(c.cache_entries[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+bool AtomicDirectMappedCache::access(int block_id, AdvancedStats& stats) {
+    if (holds(slot(block_id).load(std::memory_order_relaxed), block_id)) {
+        stats.cache_hits++;
+        return true;
+    }
+    stats.cache_misses++;
+    return false;
+}
+
+void AtomicDirectMappedCache::add_block(int block_id) {
+    std::atomic<uint64_t>& entry = slot(block_id);
+    uint64_t current = entry.load(std::memory_order_relaxed);
+    // Si otro hilo ya inserto el bloque no se pisa (podria estar marcado como sucio)
+    while (!holds(current, block_id)) {
+        if (entry.compare_exchange_weak(current, pack(block_id, VALID), std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+void AtomicDirectMappedCache::mark_dirty(int block_id) {
+    std::atomic<uint64_t>& entry = slot(block_id);
+    uint64_t current = entry.load(std::memory_order_relaxed);
+    // Solo se marca mientras la entrada siga conteniendo el bloque
+    while (holds(current, block_id) && !(current & DIRTY)) {
+        if (entry.compare_exchange_weak(current, current | DIRTY, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+long long AtomicDirectMappedCache::dirty_blocks() const {
+    long long dirty = 0;
+    for (unsigned int i = 0; i < capacity; ++i) {
+        uint64_t entry = cache_entries[i].load(std::memory_order_relaxed);
+        dirty += (entry & VALID) && (entry & DIRTY);
+    }
+    return dirty;
+}
+
+void AtomicDirectMappedCache::reset() {
+    for (unsigned int i = 0; i < capacity; ++i) {
+        cache_entries[i].store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,52 @@
+#include "BeladyOracle.hpp"
+#include <climits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+void BeladyOracle::run(const std::vector<int>& trace, AdvancedStats& stats) const {
+    int n = trace.size();
+
+    // Pasada hacia atras: posicion del siguiente uso de cada referencia
+    std::vector<int> next_use(n);
+    std::unordered_map<int, int> last_seen;
+    last_seen.reserve(n / 4 + 1);
+    for (int i = n - 1; i >= 0; --i) {
+        auto it = last_seen.find(trace[i]);
+        next_use[i] = it != last_seen.end() ? it->second : INT_MAX;
+        last_seen[trace[i]] = i;
+    }
+
+    // Bloques residentes -> proximo uso vigente. El heap (max por proximo uso)
+    // admite entradas obsoletas que se descartan al sacarlas.
+    std::unordered_map<int, int> resident;
+    resident.reserve(capacity * 2);
+    std::priority_queue<std::pair<int, int>> farthest;
+
+    for (int i = 0; i < n; ++i) {
+        int block_id = trace[i];
+        auto it = resident.find(block_id);
+        if (it != resident.end()) {
+            stats.cache_hits++;
+            it->second = next_use[i];
+        } else {
+            stats.cache_misses++;
+            if (capacity == 0) {
+                continue;
+            }
+            if (resident.size() >= capacity) {
+                while (true) {
+                    std::pair<int, int> top = farthest.top();
+                    farthest.pop();
+                    auto victim = resident.find(top.second);
+                    if (victim != resident.end() && victim->second == top.first) {
+                        resident.erase(victim);
+                        break;
+                    }
+                }
+            }
+            resident[block_id] = next_use[i];
+        }
+        farthest.push({next_use[i], block_id});
+    }
+}
@@ -0,0 +1,70 @@
+#include "ClientScheduler.hpp"
+
+ClientScheduler::ClientScheduler(FileSystem& fs, BlockDevice& device, const TimingConfig& cfg)
+    : TimedSimulation(fs, device, cfg), stats(nullptr) {}
+
+ClientScheduler::~ClientScheduler() {
+    for (SimTask::Handle h : clients) {
+        if (h) {
+            h.destroy();
+        }
+    }
+}
+
+void ClientScheduler::spawn(SimTask task) {
+    SimTask::Handle h = task.release();
+    h.promise().id = clients.size();
+    clients.push_back(h);
+    io_start.push_back(-1.0);
+    if (stats) {
+        in_flight++;
+        wake(h, now());
+    }
+}
+
+void ClientScheduler::run(AdvancedStats& run_stats) {
+    begin_run(run_stats);
+    stats = &run_stats;
+
+    for (SimTask::Handle h : clients) {
+        if (h) {
+            in_flight++;
+            wake(h, 0.0);
+        }
+    }
+
+    Event ev;
+    while (events.pop(ev)) {
+        if (ev.type != RESUME) {
+            periodic(ev, run_stats);
+            continue;
+        }
+        if (io_start[ev.data] >= 0.0) {
+            run_stats.op_latency += now() - io_start[ev.data];
+            run_stats.completed_ops++;
+            io_start[ev.data] = -1.0;
+        }
+        SimTask::Handle h = clients[ev.data];
+        h.resume();
+        if (h.done()) {
+            h.destroy();
+            clients[ev.data] = nullptr;
+            in_flight--;
+        }
+    }
+
+    stats = nullptr;
+    end_run(run_stats);
+}
+
+void ClientScheduler::io(SimTask::Handle h, int offset, int length, bool write) {
+    uint32_t id = h.promise().id;
+    begin_op(id);
+    if (write) {
+        fs.write(offset, length, *stats);
+    } else {
+        fs.read(offset, length, *stats);
+    }
+    io_start[id] = now();
+    finish_op(RESUME, id, *stats);
+}
@@ -0,0 +1,70 @@
+#include "ConfigFile.hpp"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+std::string trim(const std::string& s) {
+    size_t first = s.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = s.find_last_not_of(" \t\r");
+    return s.substr(first, last - first + 1);
+}
+
+std::string strip_comment(const std::string& line) {
+    for (size_t i = 0; i < line.size(); ++i) {
+        if ((line[i] == '#' || line[i] == ';') && (i == 0 || line[i - 1] == ' ' || line[i - 1] == '\t')) {
+            return line.substr(0, i);
+        }
+    }
+    return line;
+}
+
+}
+
+bool ConfigFile::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "no se puede leer " + path;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    if (!parse(text.str(), error)) {
+        error = path + ":" + error;
+        return false;
+    }
+    return true;
+}
+
+bool ConfigFile::parse(const std::string& text, std::string& error) {
+    parsed.clear();
+    parsed.push_back(ConfigSection());
+    std::istringstream lines(text);
+    std::string raw;
+    int number = 0;
+    while (std::getline(lines, raw)) {
+        number++;
+        std::string line = trim(strip_comment(raw));
+        if (line.empty()) {
+            continue;
+        }
+        if (line.front() == '[') {
+            if (line.back() != ']' || trim(line.substr(1, line.size() - 2)).empty()) {
+                error = std::to_string(number) + ": seccion mal formada";
+                return false;
+            }
+            parsed.push_back(ConfigSection{trim(line.substr(1, line.size() - 2)), {}});
+            continue;
+        }
+        size_t equals = line.find('=');
+        if (equals == std::string::npos || trim(line.substr(0, equals)).empty()) {
+            error = std::to_string(number) + ": se esperaba clave = valor";
+            return false;
+        }
+        parsed.back().entries.emplace_back(trim(line.substr(0, equals)), trim(line.substr(equals + 1)));
+    }
+    return true;
+}
@@ -1,16 +1,37 @@
 #include "DirectMappedCache.hpp"
+#include "Snapshot.hpp"
 
-DirectMappedCache::DirectMappedCache(int size) : Cache(size) {
-    cache_entries.resize(size, {-1, false, false});  // Inicializar entradas como inválidas
+DirectMappedCache::DirectMappedCache(int size, IndexHash hash) : Cache(size), indexer(size, hash), dirty(0), admission(nullptr),
+      shadow_2x_indexer(2 * size, hash), shadow_4x_indexer(4 * size, hash) {
+    cache_entries.resize(size, EMPTY);  // Inicializar entradas como inválidas
 }
 
-DirectMappedCache::DirectMappedCache(DirectMappedCache const &c) : Cache(c) {
+DirectMappedCache::DirectMappedCache(DirectMappedCache const &c) : Cache(c), indexer(c.indexer), dirty(c.dirty), admission(c.admission),
+      shadow_2x_indexer(c.shadow_2x_indexer), shadow_4x_indexer(c.shadow_4x_indexer),
+      shadow_2x(c.shadow_2x), shadow_4x(c.shadow_4x) {
     cache_entries = c.cache_entries;
 }
 
 bool DirectMappedCache::access(int block_id, AdvancedStats& stats) {
-    int index = block_id % capacity;  // Función de correspondencia directa
-    if (cache_entries[index].valid && cache_entries[index].block_id == block_id) {
+    if (!in_range(block_id)) {
+        stats.cache_misses++;
+        return false;
+    }
+    uint32_t index = indexer.index(block_id);  // Función de correspondencia directa
+    uint32_t tag = indexer.tag(block_id);
+    if (admission) {
+        admission->record(block_id);
+    }
+    bool hit = cache_entries[index] != EMPTY && (cache_entries[index] >> 1) == tag;
+    if (!shadow_2x.empty()) {
+        bool hit_2x = shadow_access(shadow_2x, shadow_2x_indexer, block_id);
+        bool hit_4x = shadow_access(shadow_4x, shadow_4x_indexer, block_id);
+        if (!hit) {
+            stats.ghost_hits_2x += hit_2x;
+            stats.ghost_hits_4x += hit_4x;
+        }
+    }
+    if (hit) {
         stats.cache_hits++;
         return true;
     }
@@ -18,14 +39,93 @@ bool DirectMappedCache::access(int block_id, AdvancedStats& stats) {
     return false;
 }
 
+bool DirectMappedCache::shadow_access(std::vector<uint32_t>& shadow, const SetIndexer& idx, int block_id) {
+    uint32_t& entry = shadow[idx.index(block_id)];
+    uint32_t tag = idx.tag(block_id) << 1;
+    if (entry == tag) {
+        return true;
+    }
+    entry = tag;  // En un fallo el sistema de archivos siempre inserta el bloque
+    return false;
+}
+
 void DirectMappedCache::add_block(int block_id) {
-    int index = block_id % capacity;
-    cache_entries[index] = {block_id, false, true};  // Reemplazar directamente
+    if (!in_range(block_id)) {
+        return;
+    }
+    uint32_t index = indexer.index(block_id);
+    uint32_t victim = cache_entries[index];
+    if (admission && victim != EMPTY && !admission->admit(block_id, indexer.block(victim >> 1, index))) {
+        return;  // El ocupante es mas frecuente: no se admite
+    }
+    dirty -= victim != EMPTY && (victim & DIRTY);
+    cache_entries[index] = indexer.tag(block_id) << 1;  // Reemplazar directamente (limpio)
 }
 
 void DirectMappedCache::mark_dirty(int block_id) {
-    int index = block_id % capacity;
-    if (cache_entries[index].valid && cache_entries[index].block_id == block_id) {
-        cache_entries[index].dirty = true;
+    if (!in_range(block_id)) {
+        return;
     }
-}
\ No newline at end of file
+    uint32_t index = indexer.index(block_id);
+    uint32_t tag = indexer.tag(block_id);
+    if (cache_entries[index] != EMPTY && (cache_entries[index] >> 1) == tag) {
+        dirty += !(cache_entries[index] & DIRTY);
+        cache_entries[index] |= DIRTY;
+    }
+}
+
+void DirectMappedCache::set_admission_filter(TinyLFU* filter) {
+    admission = filter;
+}
+
+void DirectMappedCache::enable_ghosts(bool enabled) {
+    if (enabled) {
+        shadow_2x.assign(2 * capacity, EMPTY);
+        shadow_4x.assign(4 * capacity, EMPTY);
+    } else {
+        shadow_2x.clear();
+        shadow_2x.shrink_to_fit();
+        shadow_4x.clear();
+        shadow_4x.shrink_to_fit();
+    }
+}
+
+void DirectMappedCache::reset() {
+    cache_entries.assign(cache_entries.size(), EMPTY);
+    dirty = 0;
+    shadow_2x.assign(shadow_2x.size(), EMPTY);
+    shadow_4x.assign(shadow_4x.size(), EMPTY);
+}
+
+void DirectMappedCache::save(SnapshotWriter& out) const {
+    out.tag("DMC2");
+    out.put<uint32_t>(capacity);
+    out.put<uint8_t>(indexer.hashing());  // Los tags y conjuntos solo valen con el mismo hash
+    out.put_vector(cache_entries);
+    out.put_vector(shadow_2x);
+    out.put_vector(shadow_4x);
+}
+
+bool DirectMappedCache::load(SnapshotReader& in) {
+    in.expect("DMC2");
+    in.expect_value<uint32_t>(capacity);
+    in.expect_value<uint8_t>(indexer.hashing());
+    std::vector<uint32_t> entries, ghosts_2x, ghosts_4x;
+    in.get_vector(entries);
+    in.get_vector(ghosts_2x);
+    in.get_vector(ghosts_4x);
+    // Las caches sombra van juntas: o las dos vacias o con 2x y 4x entradas
+    bool ghosts_off = ghosts_2x.empty() && ghosts_4x.empty();
+    bool ghosts_on = ghosts_2x.size() == 2ull * capacity && ghosts_4x.size() == 4ull * capacity;
+    if (!in.ok() || entries.size() != cache_entries.size() || !(ghosts_off || ghosts_on)) {
+        return false;
+    }
+    cache_entries.swap(entries);
+    shadow_2x.swap(ghosts_2x);
+    shadow_4x.swap(ghosts_4x);
+    dirty = 0;
+    for (uint32_t entry : cache_entries) {
+        dirty += entry != EMPTY && (entry & DIRTY);
+    }
+    return true;
+}
@@ -0,0 +1,503 @@
+#include "Experiment.hpp"
+#include "DirectMappedCache.hpp"
+#include "Ext3.hpp"
+#include "Ext4.hpp"
+#include "FullyAssociativeCache.hpp"
+#include "HardDisk.hpp"
+#include "IOScheduler.hpp"
+#include "SetAssociativeCache.hpp"
+#include "Simulator.hpp"
+#include "SkewedAssociativeCache.hpp"
+#include "SolidStateDrive.hpp"
+#include "ZCache.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+namespace {
+
+bool parse_integer(const std::string& text, long long& value) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoll(text.c_str(), &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+bool parse_real(const std::string& text, double& value) {
+    if (text.empty()) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return *end == '\0' && std::isfinite(value);
+}
+
+bool one_of(const std::string& value, std::initializer_list<const char*> options) {
+    for (const char* option : options) {
+        if (value == option) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string trim(const std::string& s) {
+    size_t first = s.find_first_not_of(" \t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return s.substr(first, s.find_last_not_of(" \t") - first + 1);
+}
+
+std::string number_text(double v, bool integer) {
+    if (integer) {
+        return std::to_string(static_cast<long long>(v));
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.10g", v);
+    return text;
+}
+
+// Expande "a..b", "a..b+paso" o "a..b*factor"; false si `item` no es un rango.
+// Un rango sin valores (b < a) es un error: el barrido no ejecutaria nada
+bool expand_range(const std::string& item, std::vector<std::string>& out, std::string& error) {
+    size_t dots = item.find("..");
+    if (dots == std::string::npos) {
+        return false;
+    }
+    std::string from = item.substr(0, dots);
+    std::string rest = item.substr(dots + 2);
+    size_t op = rest.find_first_of("+*");
+    std::string to = rest.substr(0, op);
+    std::string step = op == std::string::npos ? "1" : rest.substr(op + 1);
+    bool geometric = op != std::string::npos && rest[op] == '*';
+
+    double a, b, s;
+    if (!parse_real(from, a) || !parse_real(to, b) || !parse_real(step, s)) {
+        error = "rango mal formado: " + item;
+        return true;
+    }
+    if (geometric ? (s <= 1.0 || a <= 0.0) : s <= 0.0) {
+        error = "paso no valido en " + item;
+        return true;
+    }
+    long long dummy;
+    bool integer = parse_integer(from, dummy) && parse_integer(to, dummy) && parse_integer(step, dummy);
+    const size_t MAX_VALUES = 1 << 20;
+    double epsilon = integer ? 0.0 : 1e-9 * std::fabs(b);
+    if (a > b + epsilon) {
+        error = "rango vacio: " + item;
+        return true;
+    }
+    for (double v = a; v <= b + epsilon; v = geometric ? v * s : v + s) {
+        if (out.size() >= MAX_VALUES) {
+            error = "demasiados valores en " + item;
+            return true;
+        }
+        out.push_back(number_text(v, integer));
+    }
+    return true;
+}
+
+std::unique_ptr<Cache> make_cache(const ScenarioSpec& spec) {
+    if (spec.cache == "direct_mapped") {
+        auto cache = std::make_unique<DirectMappedCache>(spec.capacity);
+        cache->enable_ghosts(spec.ghosts);
+        return cache;
+    }
+    if (spec.cache == "set_associative") {
+        auto cache = std::make_unique<SetAssociativeCache>(spec.capacity, spec.ways);
+        cache->enable_ghosts(spec.ghosts);
+        return cache;
+    }
+    if (spec.cache == "fully_associative") {
+        return std::make_unique<FullyAssociativeCache>(spec.capacity);
+    }
+    if (spec.cache == "skewed") {
+        return std::make_unique<SkewedAssociativeCache>(spec.capacity, spec.ways);
+    }
+    return std::make_unique<ZCache>(spec.capacity, spec.ways);
+}
+
+SchedulerPolicy policy_of(const std::string& name) {
+    if (name == "noop") {
+        return NOOP;
+    }
+    if (name == "mq_deadline") {
+        return MQ_DEADLINE;
+    }
+    if (name == "bfq") {
+        return BFQ_LITE;
+    }
+    return DEADLINE;
+}
+
+KeyDistribution distribution_of(const std::string& name) {
+    if (name == "zipf") {
+        return ZIPF;
+    }
+    if (name == "scrambled_zipf") {
+        return SCRAMBLED_ZIPF;
+    }
+    if (name == "hotspot") {
+        return HOTSPOT;
+    }
+    if (name == "latest") {
+        return LATEST;
+    }
+    if (name == "sequential") {
+        return SEQUENTIAL;
+    }
+    return UNIFORM;
+}
+
+}
+
+bool set_scenario_field(ScenarioSpec& spec, const std::string& key, const std::string& value, std::string& error) {
+    long long integer = 0;
+    double real = 0.0;
+    auto bad = [&](const char* expected) {
+        error = key + " = " + value + ": se esperaba " + expected;
+        return false;
+    };
+
+    if (key == "cache") {
+        if (!one_of(value, {"direct_mapped", "set_associative", "fully_associative", "skewed", "zcache"})) {
+            return bad("direct_mapped, set_associative, fully_associative, skewed o zcache");
+        }
+        spec.cache = value;
+    } else if (key == "capacity" || key == "ways" || key == "block_size" || key == "blocks" || key == "drift_step") {
+        if (!parse_integer(value, integer) || integer < (key == "drift_step" ? 0 : 1) || integer > (1LL << 30)) {
+            return bad("un entero positivo");
+        }
+        int v = static_cast<int>(integer);
+        if (key == "capacity") {
+            spec.capacity = v;
+        } else if (key == "ways") {
+            spec.ways = v;
+        } else if (key == "block_size") {
+            spec.block_size = v;
+        } else if (key == "blocks") {
+            spec.blocks = v;
+        } else {
+            spec.drift_step = v;
+        }
+    } else if (key == "ops" || key == "drift_every" || key == "warmup_ops" || key == "seed") {
+        if (!parse_integer(value, integer) || integer < (key == "ops" ? 1 : 0)) {
+            return bad("un entero no negativo");
+        }
+        if (key == "ops") {
+            spec.ops = integer;
+        } else if (key == "drift_every") {
+            spec.drift_every = integer;
+        } else if (key == "warmup_ops") {
+            spec.warmup_ops = integer;
+        } else {
+            spec.seed = static_cast<uint64_t>(integer);
+        }
+    } else if (key == "write_ratio" || key == "theta") {
+        if (!parse_real(value, real) || real < 0.0 || (key == "write_ratio" && real > 1.0)) {
+            return bad(key == "write_ratio" ? "un valor entre 0 y 1" : "un real no negativo");
+        }
+        (key == "write_ratio" ? spec.write_ratio : spec.theta) = real;
+    } else if (key == "ghosts") {
+        if (!one_of(value, {"true", "false", "1", "0", "si", "no"})) {
+            return bad("true o false");
+        }
+        spec.ghosts = one_of(value, {"true", "1", "si"});
+    } else if (key == "filesystem") {
+        if (!one_of(value, {"ext3", "ext4"})) {
+            return bad("ext3 o ext4");
+        }
+        spec.filesystem = value;
+    } else if (key == "journaling") {
+        if (!one_of(value, {"default", "none", "metadata", "full"})) {
+            return bad("default, none, metadata o full");
+        }
+        spec.journaling = value;
+    } else if (key == "scheduler") {
+        if (!one_of(value, {"none", "noop", "deadline", "mq_deadline", "bfq"})) {
+            return bad("none, noop, deadline, mq_deadline o bfq");
+        }
+        spec.scheduler = value;
+    } else if (key == "device") {
+        if (!one_of(value, {"none", "hdd", "ssd"})) {
+            return bad("none, hdd o ssd");
+        }
+        spec.device = value;
+    } else if (key == "workload") {
+        if (!one_of(value, {"uniform", "zipf", "scrambled_zipf", "hotspot", "latest", "sequential", "secuencial",
+                            "aleatorio"})) {
+            return bad("uniform, zipf, scrambled_zipf, hotspot, latest, sequential, secuencial o aleatorio");
+        }
+        spec.workload = value;
+    } else {
+        error = "clave desconocida: " + key;
+        return false;
+    }
+    return true;
+}
+
+bool ScenarioSweep::set(const std::string& key, const std::string& values, std::string& error) {
+    Axis axis{key, {}};
+    size_t start = 0;
+    while (start <= values.size()) {
+        size_t comma = values.find(',', start);
+        std::string item = trim(values.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        start = comma == std::string::npos ? values.size() + 1 : comma + 1;
+        if (item.empty()) {
+            error = key + ": valor vacio";
+            return false;
+        }
+        error.clear();
+        if (!expand_range(item, axis.values, error)) {
+            axis.values.push_back(item);
+        } else if (!error.empty()) {
+            error = key + ": " + error;
+            return false;
+        }
+    }
+    ScenarioSpec scratch;
+    for (const std::string& value : axis.values) {
+        if (!set_scenario_field(scratch, key, value, error)) {
+            return false;
+        }
+    }
+    bool replaced = false;
+    for (Axis& existing : axes) {
+        if (existing.key == key) {
+            existing = axis;
+            replaced = true;
+        }
+    }
+    if (!replaced) {
+        axes.push_back(axis);
+    }
+    if (size() < 0) {
+        error = "demasiados escenarios en " + name;
+        return false;
+    }
+    return true;
+}
+
+long long ScenarioSweep::size() const {
+    const long long LIMIT = 1LL << 40;
+    long long total = 1;
+    for (const Axis& axis : axes) {
+        total *= static_cast<long long>(axis.values.size());
+        if (total > LIMIT) {
+            return -1;
+        }
+    }
+    return total;
+}
+
+ScenarioSpec ScenarioSweep::at(long long index) const {
+    ScenarioSpec spec;
+    spec.name = size() > 1 ? name + "#" + std::to_string(index) : name;
+    std::string ignored;
+    for (size_t a = axes.size(); a-- > 0;) {
+        long long n = static_cast<long long>(axes[a].values.size());
+        set_scenario_field(spec, axes[a].key, axes[a].values[index % n], ignored);
+        index /= n;
+    }
+    return spec;
+}
+
+bool build_sweeps(const ConfigFile& config, const std::vector<std::pair<std::string, std::string>>& overrides,
+                  std::vector<ScenarioSweep>& sweeps, std::string& error) {
+    std::vector<std::pair<std::string, std::string>> defaults;
+    std::vector<const ConfigSection*> own;
+    for (const ConfigSection& section : config.sections()) {
+        if (section.name.empty() || section.name == "defaults") {
+            defaults.insert(defaults.end(), section.entries.begin(), section.entries.end());
+        } else {
+            own.push_back(&section);
+        }
+    }
+
+    auto build = [&](const std::string& name, const std::vector<std::pair<std::string, std::string>>* entries) {
+        ScenarioSweep sweep(name);
+        const std::vector<std::pair<std::string, std::string>>* lists[] = {&defaults, entries, &overrides};
+        for (const auto* list : lists) {
+            if (!list) {
+                continue;
+            }
+            for (const auto& entry : *list) {
+                if (!sweep.set(entry.first, entry.second, error)) {
+                    error = "[" + name + "] " + error;
+                    return false;
+                }
+            }
+        }
+        sweeps.push_back(sweep);
+        return true;
+    };
+
+    sweeps.clear();
+    if (own.empty()) {
+        return build("barrido", nullptr);
+    }
+    for (const ConfigSection* section : own) {
+        if (!build(section->name, &section->entries)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool run_scenario(const ScenarioSpec& spec, AdvancedStats& stats, std::string& error) {
+    bool uses_ways = spec.cache == "set_associative" || spec.cache == "skewed" || spec.cache == "zcache";
+    if (uses_ways && spec.ways > spec.capacity) {
+        error = spec.name + ": mas vias que bloques";
+        return false;
+    }
+    if (spec.filesystem == "ext4" && spec.journaling != "default") {
+        // Ext4::set_journal_mode no cambia nada: la fila quedaria mal etiquetada
+        error = spec.name + ": ext4 no admite journaling=" + spec.journaling;
+        return false;
+    }
+    std::unique_ptr<Cache> cache = make_cache(spec);
+
+    std::unique_ptr<FileSystem> fs;
+    if (spec.filesystem == "ext3") {
+        fs = std::make_unique<Ext3>(*cache, spec.block_size);
+    } else {
+        fs = std::make_unique<Ext4>(*cache, spec.block_size);
+    }
+    if (spec.journaling != "default") {
+        fs->set_journal_mode(spec.journaling == "none" ? NO_JOURNALING
+                             : spec.journaling == "full" ? FULL_JOURNALING : METADATA_JOURNALING);
+    }
+
+    std::unique_ptr<BlockDevice> device;
+    if (spec.device == "hdd") {
+        device = std::make_unique<HardDisk>();
+    } else if (spec.device == "ssd") {
+        device = std::make_unique<SolidStateDrive>();
+    }
+    std::unique_ptr<IOScheduler> scheduler;
+    if (spec.scheduler != "none") {
+        SchedulerConfig sched_config;
+        sched_config.policy = policy_of(spec.scheduler);
+        scheduler = std::make_unique<IOScheduler>(sched_config);
+        scheduler->set_device(device.get());
+        fs->set_io_scheduler(scheduler.get());
+    } else {
+        fs->set_io_scheduler(device.get());
+    }
+
+    RunConfig config;
+    config.write_ratio = spec.write_ratio;
+    config.window_ops = 0;
+    if (spec.warmup_ops > 0) {
+        config.warmup.mode = WARMUP_OPS;
+        config.warmup.ops = spec.warmup_ops;
+    }
+
+    if (spec.workload == "secuencial" || spec.workload == "aleatorio") {
+        run_simulation(*fs, AccessPattern(spec.ops, spec.workload == "secuencial"), stats, config);
+        return true;
+    }
+    PhaseSpec phase;
+    phase.ops = spec.ops;
+    phase.write_ratio = spec.write_ratio;
+    phase.keys[0].distribution = distribution_of(spec.workload);
+    phase.keys[0].num_blocks = spec.blocks;
+    phase.keys[0].zipf_theta = spec.theta;
+    phase.keys[0].drift_every = spec.drift_every;
+    phase.keys[0].drift_step = spec.drift_step;
+    Workload workload(spec.block_size, spec.seed);
+    if (!workload.add_phase(phase)) {
+        error = spec.name + ": fase de carga no valida";
+        return false;
+    }
+    run_simulation(*fs, workload, stats, config);
+    return true;
+}
+
+RunDescription describe(const ScenarioSpec& spec) {
+    RunDescription run;
+    run.scenario = spec.name;
+    run.filesystem = spec.filesystem;
+    run.cache = spec.cache;
+    run.capacity = spec.capacity;
+    run.ways = spec.cache == "direct_mapped" ? 1 : spec.cache == "fully_associative" ? spec.capacity : spec.ways;
+    run.block_size = spec.block_size;
+    if (spec.journaling == "default") {
+        run.journaling = spec.filesystem == "ext3" ? METADATA_JOURNALING : NO_JOURNALING;
+    } else {
+        run.journaling = spec.journaling == "none" ? NO_JOURNALING
+                         : spec.journaling == "full" ? FULL_JOURNALING : METADATA_JOURNALING;
+    }
+    run.scheduler = spec.scheduler == "none" ? "" : spec.scheduler;
+    run.device = spec.device == "none" ? "" : spec.device;
+    run.workload = spec.workload;
+    run.ops = spec.ops;
+    run.write_ratio = spec.write_ratio;
+    return run;
+}
+
+long long run_sweeps(const std::vector<ScenarioSweep>& sweeps, int threads, ResultsWriter& results,
+                     std::ostream& errors) {
+    // Por tandas: los hilos se reparten los escenarios de la tanda con un
+    // contador atomico y el hilo principal escribe sus resultados en orden
+    const long long BATCH = 4096;
+    threads = threads > 0 ? threads : 1;
+    std::vector<ScenarioSpec> specs;
+    std::vector<AdvancedStats> outcome;
+    std::vector<std::string> failure;
+    long long failed = 0;
+
+    for (const ScenarioSweep& sweep : sweeps) {
+        long long total = sweep.size();
+        if (total <= 0) {
+            errors << sweep.label() << ": barrido sin escenarios\n";
+            failed++;
+            continue;
+        }
+        for (long long first = 0; first < total; first += BATCH) {
+            long long count = std::min(BATCH, total - first);
+            specs.resize(count);
+            outcome.resize(count);
+            failure.assign(count, std::string());
+            for (long long i = 0; i < count; ++i) {
+                specs[i] = sweep.at(first + i);
+            }
+
+            std::atomic<long long> next(0);
+            auto worker = [&]() {
+                for (long long i = next++; i < count; i = next++) {
+                    if (!run_scenario(specs[i], outcome[i], failure[i]) && failure[i].empty()) {
+                        failure[i] = specs[i].name + ": no se pudo ejecutar";
+                    }
+                }
+            };
+            std::vector<std::thread> pool;
+            for (int t = 1; t < threads && t < count; ++t) {
+                pool.emplace_back(worker);
+            }
+            worker();
+            for (std::thread& t : pool) {
+                t.join();
+            }
+
+            for (long long i = 0; i < count; ++i) {
+                if (!failure[i].empty()) {
+                    errors << failure[i] << "\n";
+                    failed++;
+                } else {
+                    results.add(describe(specs[i]), outcome[i]);
+                }
+            }
+        }
+    }
+    return failed;
+}
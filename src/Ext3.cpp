@@ -1,4 +1,5 @@
 #include "Ext3.hpp"
+#include "Snapshot.hpp"
 
 // Implementación Ext3
 
@@ -7,55 +8,69 @@ Ext3::Ext3(Cache& c, int bs) : FileSystem(bs), cache(c) {
     journal_mode = METADATA_JOURNALING;
 }
 
-void Ext3::journal_operation(int address, AdvancedStats& stats) {
+void Ext3::journal_operation(AdvancedStats& stats) {
     stats.journal_ops++;
     // Acceso al journal (bloque especial 0)
     if (!cache.access(0, stats)) {
         cache.add_block(0);
-        stats.disk_reads++;
+        disk_read(0, 1, stats);
     }
 }
-    
-void Ext3::read(int address, AdvancedStats& stats){
-    int block_id = address / block_size;
-    
+
+void Ext3::metadata_access(AdvancedStats& stats) {
     // Acceso a metadatos (bloque 1)
     if (!cache.access(1, stats)) {
         cache.add_block(1);
-        stats.disk_reads++;
+        disk_read(1, 1, stats);
     }
+}
+    
+void Ext3::read(int offset, int length, AdvancedStats& stats){
+    metadata_access(stats);
 
-    if (cache.access(block_id, stats)) {
-        return;
+    // Una peticion de disco por cada tramo contiguo que no esta en cache
+    lookup_range(cache, first_block_of(offset), last_block_of(offset, length), stats);
+    for (const BlockRun& run : missing) {
+        disk_read(run.first_block, run.num_blocks, stats);
     }
-    
-    cache.add_block(block_id);
-    stats.disk_reads++;
 }
     
-void Ext3::write(int address, AdvancedStats& stats){
-    int block_id = address / block_size;
+void Ext3::write(int offset, int length, AdvancedStats& stats){
+    int first_block = first_block_of(offset);
+    int last_block = last_block_of(offset, length);
     
     // Journaling
     if (journal_mode != NO_JOURNALING) {
-        journal_operation(address, stats);
+        journal_operation(stats);
     }
 
-    // Acceso a metadatos
-    if (!cache.access(1, stats)) {
-        cache.add_block(1);
-        stats.disk_reads++;
-    }
+    metadata_access(stats);
 
-    if (!cache.access(block_id, stats)) {
-        cache.add_block(block_id);
-        stats.disk_reads++;
+    lookup_range(cache, first_block, last_block, stats);
+    for (const BlockRun& run : missing) {
+        disk_read(run.first_block, run.num_blocks, stats);
     }
     
-    cache.mark_dirty(block_id);
-    stats.disk_writes++;
+    // Escritura inmediata de todo el rango
+    for (int block_id = first_block; block_id <= last_block; ++block_id) {
+        cache.mark_dirty(block_id);
+    }
+    disk_write(first_block, last_block - first_block + 1, stats);
 }
     
 void Ext3::set_journal_mode(JournalingMode mode){
     journal_mode = mode;
-}
\ No newline at end of file
+}
+
+void Ext3::save(SnapshotWriter& out) const {
+    FileSystem::save(out);
+    out.tag("EXT3");
+    cache.save(out);
+}
+
+bool Ext3::load(SnapshotReader& in) {
+    if (!FileSystem::load(in) || !in.expect("EXT3")) {
+        return false;
+    }
+    return cache.load(in);
+}
@@ -1,4 +1,5 @@
 #include "Ext4.hpp"
+#include "Snapshot.hpp"
 
 // Implementación ext4
 
@@ -7,38 +8,61 @@ Ext4::Ext4(Cache& c, int bs) : FileSystem(bs), cache(c) {
     delayed_allocation = true;
 }
 
-void Ext4::extent_access(int address, AdvancedStats& stats) {
-    // Simular acceso por extensiones (4 bloques contiguos)
-    int base_block = (address / block_size) & ~3;
-    for (int i = 0; i < 4; ++i) {
-        if (!cache.access(base_block + i, stats)) {
-            cache.add_block(base_block + i);
-            stats.disk_reads++;
-        }
+void Ext4::extent_access(int first_block, int last_block, AdvancedStats& stats) {
+    // Simular acceso por extensiones (grupos alineados de 4 bloques contiguos)
+    int base_block = first_block & ~3;
+    int end_block = last_block | 3;
+    lookup_range(cache, base_block, end_block, stats);
+    for (const BlockRun& run : missing) {
+        disk_read(run.first_block, run.num_blocks, stats);
     }
 }
 
-void Ext4::read(int address, AdvancedStats& stats){
+void Ext4::read(int offset, int length, AdvancedStats& stats){
     // Acceso mediante extensiones
-    extent_access(address, stats);
+    extent_access(first_block_of(offset), last_block_of(offset, length), stats);
 }
 
-void Ext4::write(int address, AdvancedStats& stats){
+void Ext4::write(int offset, int length, AdvancedStats& stats){
+    int first_block = first_block_of(offset);
+    int last_block = last_block_of(offset, length);
+
     // Escritura diferida
     if (delayed_allocation) {
-        int block_id = address / block_size;
-        if (!cache.access(block_id, stats)) {
-            cache.add_block(block_id);
-            stats.disk_writes++;
+        // Solo se asignan y escriben los bloques que no estaban en cache
+        lookup_range(cache, first_block, last_block, stats);
+        for (const BlockRun& run : missing) {
+            disk_write(run.first_block, run.num_blocks, stats);
         }
-        cache.mark_dirty(block_id);
     } else {
         // Similar a ext3 pero con extensiones
-        extent_access(address, stats);
-        stats.disk_writes++;
+        extent_access(first_block, last_block, stats);
+        disk_write(first_block, last_block - first_block + 1, stats);
+    }
+    for (int block_id = first_block; block_id <= last_block; ++block_id) {
+        cache.mark_dirty(block_id);
     }
 }
 
-void Ext4::set_journal_mode(JournalingMode mode){
+void Ext4::set_journal_mode(JournalingMode){
     // Ext4 siempre usa journaling con checksum
-}
\ No newline at end of file
+}
+
+void Ext4::save(SnapshotWriter& out) const {
+    FileSystem::save(out);
+    out.tag("EXT4");
+    out.put(delayed_allocation);
+    cache.save(out);
+}
+
+bool Ext4::load(SnapshotReader& in) {
+    if (!FileSystem::load(in) || !in.expect("EXT4")) {
+        return false;
+    }
+    bool delayed = delayed_allocation;
+    if (!in.get(delayed)) {
+        return false;
+    }
+    delayed_allocation = delayed;
+    return cache.load(in);
+}
@@ -0,0 +1,93 @@
+#include "FastRandom.hpp"
+#include <cstring>
+
+void Xoshiro256pp::jump() {
+    static const uint64_t JUMP[] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+    uint64_t t[4] = {0, 0, 0, 0};
+    for (uint64_t j : JUMP) {
+        for (int b = 0; b < 64; ++b) {
+            if (j & (1ull << b)) {
+                for (int i = 0; i < 4; ++i) {
+                    t[i] ^= s[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        s[i] = t[i];
+    }
+}
+
+XoshiroBatch::XoshiroBatch(uint64_t seed) {
+    this->seed(seed);
+}
+
+void XoshiroBatch::seed(uint64_t seed) {
+    Xoshiro256pp lane(seed);
+    for (int l = 0; l < LANES; ++l) {
+        // Copiar el estado del generador escalar a la via l
+        uint64_t words[4];
+        lane.state(words);
+        s0[l] = words[0];
+        s1[l] = words[1];
+        s2[l] = words[2];
+        s3[l] = words[3];
+        lane.jump();
+    }
+    scalar = lane;
+}
+
+void XoshiroBatch::fill(uint64_t* out, size_t n) {
+    // Las LANES vias se procesan como vectores (extensiones de GCC/Clang): con
+    // AVX2 cada operacion cubre 4 vias, sin AVX2 el compilador usa pares SSE2
+    typedef uint64_t lanes __attribute__((vector_size(LANES * sizeof(uint64_t))));
+    lanes a, b, c, d;
+    std::memcpy(&a, s0, sizeof(a));
+    std::memcpy(&b, s1, sizeof(b));
+    std::memcpy(&c, s2, sizeof(c));
+    std::memcpy(&d, s3, sizeof(d));
+
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        lanes sum = a + d;
+        lanes result = ((sum << 23) | (sum >> 41)) + a;
+        lanes t = b << 17;
+        c ^= a;
+        d ^= b;
+        b ^= c;
+        a ^= d;
+        c ^= t;
+        d = (d << 45) | (d >> 19);
+        std::memcpy(out + i, &result, sizeof(result));
+    }
+
+    std::memcpy(s0, &a, sizeof(a));
+    std::memcpy(s1, &b, sizeof(b));
+    std::memcpy(s2, &c, sizeof(c));
+    std::memcpy(s3, &d, sizeof(d));
+    for (; i < n; ++i) {
+        out[i] = scalar();
+    }
+}
+
+void XoshiroBatch::fill_bounded(uint32_t* out, size_t n, uint32_t range) {
+    uint64_t raw[256];
+    uint32_t threshold = -range % range;
+    while (n > 0) {
+        size_t chunk = n < 256 ? n : 256;
+        fill(raw, chunk);
+        for (size_t i = 0; i < chunk; ++i) {
+            uint64_t m = (raw[i] >> 32) * range;
+            if (static_cast<uint32_t>(m) < threshold) {
+                out[i] = scalar.bounded(range);  // Rechazo: valor nuevo sin sesgo
+            } else {
+                out[i] = m >> 32;
+            }
+        }
+        out += chunk;
+        n -= chunk;
+    }
+}
@@ -0,0 +1,72 @@
+#include "FileSystem.hpp"
+#include "Snapshot.hpp"
+
+void FileSystem::disk_read(int first_block, int num_blocks, AdvancedStats& stats) {
+    stats.disk_reads += num_blocks;
+    stats.read_iops++;
+    stats.bytes_read += static_cast<long long>(num_blocks) * block_size;
+    if (sink) {
+        sink->submit({first_block, num_blocks, false, 0}, stats);
+    } else {
+        stats.issued_requests++;
+    }
+}
+
+void FileSystem::disk_write(int first_block, int num_blocks, AdvancedStats& stats) {
+    stats.disk_writes += num_blocks;
+    stats.write_iops++;
+    stats.bytes_written += static_cast<long long>(num_blocks) * block_size;
+    if (sink) {
+        sink->submit({first_block, num_blocks, true, 0}, stats);
+    } else {
+        stats.issued_requests++;
+    }
+}
+
+void FileSystem::lookup_range(Cache& cache, int first_block, int last_block, AdvancedStats& stats) {
+    missing.clear();
+    for (int block_id = first_block; block_id <= last_block; ++block_id) {
+        if (cache.access(block_id, stats)) {
+            continue;
+        }
+        cache.add_block(block_id);
+        if (!missing.empty() && missing.back().first_block + missing.back().num_blocks == block_id) {
+            missing.back().num_blocks++;
+        } else {
+            missing.push_back({block_id, 1});
+        }
+    }
+}
+
+void FileSystem::save(SnapshotWriter& out) const {
+    out.tag("FSY1");
+    out.put(block_size);
+    out.put(journal_mode);
+    out.put(use_extents);
+}
+
+bool FileSystem::load(SnapshotReader& in) {
+    in.expect("FSY1");
+    in.expect_value(block_size);
+    JournalingMode mode = journal_mode;
+    bool extents = use_extents;
+    in.get(mode);
+    in.get(extents);
+    if (!in.ok()) {
+        return false;
+    }
+    journal_mode = mode;
+    use_extents = extents;
+    return true;
+}
+
+bool FileSystem::save_snapshot(const std::string& path) const {
+    SnapshotWriter out;
+    save(out);
+    return out.write_file(path);
+}
+
+bool FileSystem::load_snapshot(const std::string& path) {
+    SnapshotReader in(path);
+    return in.ok() && load(in);
+}
@@ -0,0 +1,191 @@
+#include "FullyAssociativeCache.hpp"
+#include <algorithm>
+#include <utility>
+#include "Snapshot.hpp"
+
+FullyAssociativeCache::FullyAssociativeCache(int size)
+    : Cache(std::max(size, 1)), head(NIL), tail(NIL), used(0) {
+    slots.resize(capacity, {0, NIL, NIL, false});
+
+    uint32_t table_size = 2;
+    table_shift = 31;
+    while (table_size < 2 * capacity) {
+        table_size <<= 1;
+        table_shift--;
+    }
+    table.resize(table_size, {0, NIL});
+    table_mask = table_size - 1;
+}
+
+FullyAssociativeCache::FullyAssociativeCache(FullyAssociativeCache const &c)
+    : Cache(c), slots(c.slots), table(c.table), table_mask(c.table_mask), table_shift(c.table_shift),
+      head(c.head), tail(c.tail), used(c.used) {}
+
+uint32_t FullyAssociativeCache::find(uint32_t block) const {
+    uint32_t pos = home(block);
+    // Robin Hood: si la distancia del bucket actual es menor que la recorrida,
+    // el bloque buscado no puede estar mas adelante
+    for (uint32_t dist = 0; table[pos].slot != NIL && dist <= distance(pos); ++dist) {
+        if (table[pos].block == block) {
+            return pos;
+        }
+        pos = (pos + 1) & table_mask;
+    }
+    return NIL;
+}
+
+void FullyAssociativeCache::table_insert(uint32_t block, uint32_t slot) {
+    Bucket carry = {block, slot};
+    uint32_t pos = home(block);
+    for (uint32_t dist = 0;; ++dist) {
+        if (table[pos].slot == NIL) {
+            table[pos] = carry;
+            return;
+        }
+        uint32_t existing = distance(pos);
+        if (existing < dist) {
+            // El residente esta mas cerca de su casa: cederle el sitio al mas lejano
+            std::swap(carry, table[pos]);
+            dist = existing;
+        }
+        pos = (pos + 1) & table_mask;
+    }
+}
+
+void FullyAssociativeCache::table_erase(uint32_t pos) {
+    // Borrado con desplazamiento hacia atras (sin lapidas)
+    uint32_t next = (pos + 1) & table_mask;
+    while (table[next].slot != NIL && distance(next) > 0) {
+        table[pos] = table[next];
+        pos = next;
+        next = (next + 1) & table_mask;
+    }
+    table[pos].slot = NIL;
+}
+
+void FullyAssociativeCache::unlink(uint32_t slot) {
+    Slot& s = slots[slot];
+    if (s.prev != NIL) {
+        slots[s.prev].next = s.next;
+    } else {
+        head = s.next;
+    }
+    if (s.next != NIL) {
+        slots[s.next].prev = s.prev;
+    } else {
+        tail = s.prev;
+    }
+}
+
+void FullyAssociativeCache::push_front(uint32_t slot) {
+    slots[slot].prev = NIL;
+    slots[slot].next = head;
+    if (head != NIL) {
+        slots[head].prev = slot;
+    } else {
+        tail = slot;
+    }
+    head = slot;
+}
+
+bool FullyAssociativeCache::access(int block_id, AdvancedStats& stats) {
+    uint32_t pos = find(static_cast<uint32_t>(block_id));
+    if (pos != NIL) {
+        uint32_t slot = table[pos].slot;
+        if (slot != head) {
+            unlink(slot);
+            push_front(slot);
+        }
+        stats.cache_hits++;
+        return true;
+    }
+    stats.cache_misses++;
+    return false;
+}
+
+void FullyAssociativeCache::add_block(int block_id) {
+    uint32_t block = static_cast<uint32_t>(block_id);
+    uint32_t pos = find(block);
+    if (pos != NIL) {
+        uint32_t slot = table[pos].slot;
+        unlink(slot);
+        push_front(slot);
+        return;
+    }
+
+    uint32_t slot;
+    if (used < capacity) {
+        slot = used++;
+    } else {
+        // Desalojar el menos recientemente usado
+        slot = tail;
+        table_erase(find(slots[slot].block));
+        unlink(slot);
+    }
+    slots[slot].block = block;
+    slots[slot].dirty = false;
+    push_front(slot);
+    table_insert(block, slot);
+}
+
+void FullyAssociativeCache::mark_dirty(int block_id) {
+    uint32_t pos = find(static_cast<uint32_t>(block_id));
+    if (pos != NIL) {
+        slots[table[pos].slot].dirty = true;
+    }
+}
+
+void FullyAssociativeCache::reset() {
+    slots.assign(slots.size(), {0, NIL, NIL, false});
+    table.assign(table.size(), {0, NIL});
+    head = NIL;
+    tail = NIL;
+    used = 0;
+}
+
+long long FullyAssociativeCache::dirty_blocks() const {
+    long long dirty = 0;
+    for (uint32_t slot = 0; slot < used; ++slot) {
+        dirty += slots[slot].dirty;
+    }
+    return dirty;
+}
+
+void FullyAssociativeCache::save(SnapshotWriter& out) const {
+    // Se guarda la lista LRU de mas a menos reciente; la tabla hash se
+    // reconstruye al cargar
+    out.tag("FAC2");
+    out.put<uint32_t>(capacity);
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> dirty;
+    order.reserve(used);
+    dirty.reserve(used);
+    for (uint32_t s = head; s != NIL; s = slots[s].next) {
+        order.push_back(slots[s].block);
+        dirty.push_back(slots[s].dirty);
+    }
+    out.put_vector(order);
+    out.put_vector(dirty);
+}
+
+bool FullyAssociativeCache::load(SnapshotReader& in) {
+    in.expect("FAC2");
+    in.expect_value<uint32_t>(capacity);
+    std::vector<uint32_t> order;
+    std::vector<uint8_t> dirty;
+    in.get_vector(order);
+    in.get_vector(dirty);
+    if (!in.ok() || order.size() > capacity || dirty.size() != order.size()) {
+        return false;
+    }
+    reset();
+    // Insertar del menos al mas reciente deja el orden LRU original
+    for (size_t i = order.size(); i-- > 0;) {
+        uint32_t slot = used++;
+        slots[slot].block = order[i];
+        slots[slot].dirty = dirty[i] != 0;
+        push_front(slot);
+        table_insert(order[i], slot);
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#include "HardDisk.hpp"
+#include <cmath>
+
+HardDisk::HardDisk(const HardDiskGeometry& geo) : geometry(geo), capacity(0), current_cylinder(0) {
+    revolution_ms = 60000.0 / geometry.rpm;
+
+    int cylinders_per_zone = geometry.cylinders / geometry.zones;
+    for (int z = 0; z < geometry.zones; ++z) {
+        // Densidad lineal constante: los bloques por pista bajan hacia el centro
+        int bpt = geometry.outer_blocks_per_track -
+                  (geometry.outer_blocks_per_track - geometry.inner_blocks_per_track) * z / (geometry.zones > 1 ? geometry.zones - 1 : 1);
+        zone_table.push_back({capacity, z * cylinders_per_zone, bpt});
+        capacity += static_cast<long long>(cylinders_per_zone) * geometry.heads * bpt;
+    }
+}
+
+const HardDisk::Zone& HardDisk::zone_of(long long block) const {
+    int z = zone_table.size() - 1;
+    while (z > 0 && zone_table[z].first_block > block) {
+        --z;
+    }
+    return zone_table[z];
+}
+
+double HardDisk::seek_time(int distance) const {
+    if (distance == 0) {
+        return 0.0;
+    }
+    double span = geometry.cylinders > 1 ? geometry.cylinders - 1 : 1;
+    return geometry.min_seek_ms + (geometry.max_seek_ms - geometry.min_seek_ms) * std::sqrt(distance / span) + geometry.settle_ms;
+}
+
+double HardDisk::service(const DiskRequest& request, double now, AdvancedStats&) {
+    long long block = request.first_block % capacity;
+    const Zone& zone = zone_of(block);
+
+    long long offset = block - zone.first_block;
+    long long track = offset / zone.blocks_per_track;
+    int cylinder = zone.first_cylinder + static_cast<int>(track / geometry.heads);
+    int sector = static_cast<int>(offset % zone.blocks_per_track);
+
+    double t = now + seek_time(cylinder > current_cylinder ? cylinder - current_cylinder : current_cylinder - cylinder);
+    current_cylinder = cylinder;
+
+    // Espera hasta que el sector pase bajo el cabezal
+    double angle = std::fmod(t, revolution_ms) / revolution_ms;
+    double target = static_cast<double>(sector) / zone.blocks_per_track;
+    double wait = target - angle;
+    if (wait < 0.0) {
+        wait += 1.0;
+    }
+    if (wait > 1.0 - 1e-9) {
+        wait = 0.0;  // Redondeo: el sector acaba de llegar
+    }
+    t += wait * revolution_ms;
+
+    // Transferencia a la velocidad de la zona; los cambios de pista se ignoran
+    t += revolution_ms * request.num_blocks / zone.blocks_per_track;
+    return t;
+}
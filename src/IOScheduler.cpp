@@ -0,0 +1,191 @@
+#include "IOScheduler.hpp"
+
+IOScheduler::IOScheduler(const SchedulerConfig& cfg)
+    : config(cfg), device(nullptr), arrivals(0), head(0), starved(0), serving_writes(false), budget_left(cfg.bfq_budget) {
+    queue.reserve(cfg.queue_depth + 1);
+    chain.reserve(cfg.queue_depth + 1);
+}
+
+void IOScheduler::submit(const DiskRequest& request, AdvancedStats& stats) {
+    enqueue(request, stats);
+    if (static_cast<int>(queue.size()) >= config.queue_depth) {
+        int batch = config.policy == MQ_DEADLINE ? config.fifo_batch : 1;
+        for (int i = 0; i < batch && !queue.empty(); ++i) {
+            dispatch_one(stats);
+        }
+    }
+}
+
+long long IOScheduler::enqueue(const DiskRequest& request, AdvancedStats& stats) {
+    DiskRequest incoming = request;
+    incoming.arrival = arrivals++;
+
+    int member = 0;
+    if (free_members.empty()) {
+        member = members.size();
+        members.push_back({incoming.arrival, -1});
+    } else {
+        member = free_members.back();
+        free_members.pop_back();
+        members[member] = {incoming.arrival, -1};
+    }
+
+    for (int i = 0; i < static_cast<int>(queue.size()); ++i) {
+        DiskRequest& queued = queue[i];
+        if (queued.write != incoming.write || queued.num_blocks + incoming.num_blocks > config.max_request_blocks) {
+            continue;
+        }
+        if (queued.first_block + queued.num_blocks == incoming.first_block) {
+            // Fusion por detras: la nueva continua a la encolada
+            queued.num_blocks += incoming.num_blocks;
+        } else if (incoming.first_block + incoming.num_blocks == queued.first_block) {
+            // Fusion por delante: conserva la antiguedad de la encolada
+            queued.first_block = incoming.first_block;
+            queued.num_blocks += incoming.num_blocks;
+        } else {
+            continue;
+        }
+        stats.merged_requests++;
+        members[member].next = chain[i];
+        chain[i] = member;
+        return incoming.arrival;
+    }
+
+    queue.push_back(incoming);
+    chain.push_back(member);
+    return incoming.arrival;
+}
+
+void IOScheduler::flush(AdvancedStats& stats) {
+    while (!queue.empty()) {
+        dispatch_one(stats);
+    }
+    if (device) {
+        device->flush(stats);
+    }
+}
+
+int IOScheduler::pick_fifo() const {
+    int oldest = 0;
+    for (int i = 1; i < static_cast<int>(queue.size()); ++i) {
+        if (queue[i].arrival < queue[oldest].arrival) {
+            oldest = i;
+        }
+    }
+    return oldest;
+}
+
+int IOScheduler::pick_elevator(bool writes) const {
+    // C-SCAN: la peticion mas cercana por delante del cabezal; si no hay, la
+    // de menor bloque (vuelta al principio). -1 si no hay peticiones de ese tipo
+    int ahead = -1;
+    int lowest = -1;
+    for (int i = 0; i < static_cast<int>(queue.size()); ++i) {
+        const DiskRequest& r = queue[i];
+        if (r.write != writes) {
+            continue;
+        }
+        if (r.first_block >= head && (ahead < 0 || r.first_block < queue[ahead].first_block)) {
+            ahead = i;
+        }
+        if (lowest < 0 || r.first_block < queue[lowest].first_block) {
+            lowest = i;
+        }
+    }
+    return ahead >= 0 ? ahead : lowest;
+}
+
+int IOScheduler::pick_deadline() {
+    long long now = arrivals;
+    // Primero las peticiones vencidas (lecturas antes que escrituras)
+    int expired = -1;
+    for (int i = 0; i < static_cast<int>(queue.size()); ++i) {
+        const DiskRequest& r = queue[i];
+        long long expire = r.write ? config.write_expire : config.read_expire;
+        if (now - r.arrival > expire &&
+            (expired < 0 || (!r.write && queue[expired].write) ||
+             (r.write == queue[expired].write && r.arrival < queue[expired].arrival))) {
+            expired = i;
+        }
+    }
+    if (expired >= 0) {
+        return expired;
+    }
+
+    int read = pick_elevator(false);
+    int write = pick_elevator(true);
+    if (read >= 0 && (write < 0 || starved < config.writes_starved)) {
+        starved = write >= 0 ? starved + 1 : 0;
+        return read;
+    }
+    starved = 0;
+    return write;
+}
+
+int IOScheduler::pick_bfq() {
+    int current = pick_elevator(serving_writes);
+    if (current < 0 || budget_left <= 0) {
+        // Cola vacia o presupuesto agotado: turno de la otra cola si tiene trabajo
+        int other = pick_elevator(!serving_writes);
+        if (other >= 0) {
+            serving_writes = !serving_writes;
+            budget_left = config.bfq_budget;
+            return other;
+        }
+        budget_left = config.bfq_budget;
+    }
+    return current;
+}
+
+void IOScheduler::dispatch_one(AdvancedStats& stats) {
+    DiskRequest request;
+    take(request);
+    issue(request, stats);
+}
+
+bool IOScheduler::take(DiskRequest& request, std::vector<long long>* merged) {
+    if (queue.empty()) {
+        return false;
+    }
+    int index = 0;
+    switch (config.policy) {
+        case NOOP:
+            index = pick_fifo();
+            break;
+        case DEADLINE:
+        case MQ_DEADLINE:
+            index = pick_deadline();
+            break;
+        case BFQ_LITE:
+            index = pick_bfq();
+            budget_left -= queue[index].num_blocks;
+            break;
+    }
+
+    request = queue[index];
+    queue[index] = queue.back();
+    queue.pop_back();
+
+    if (merged) {
+        merged->clear();
+    }
+    for (int m = chain[index]; m >= 0; m = members[m].next) {
+        if (merged) {
+            merged->push_back(members[m].arrival);
+        }
+        free_members.push_back(m);
+    }
+    chain[index] = chain.back();
+    chain.pop_back();
+
+    head = request.first_block + request.num_blocks;
+    return true;
+}
+
+void IOScheduler::issue(const DiskRequest& request, AdvancedStats& stats) {
+    if (device) {
+        device->submit(request, stats);
+    } else {
+        stats.issued_requests++;
+    }
+}
@@ -0,0 +1,136 @@
+#include "MetricsWriter.hpp"
+#include <cstring>
+
+namespace {
+    // Una fila formateada nunca supera este tamano (mas la etiqueta)
+    const size_t MAX_ROW = 768;
+
+    const char* CSV_HEADER =
+        "run,first_op,ops,time_ms,warmup,hit_ratio,cache_hits,cache_misses,disk_reads,disk_writes,"
+        "read_iops,write_iops,journal_ops,issued_requests,dirty_blocks,dirty_ratio,"
+        "latency_p50_ms,latency_p99_ms,latency_p999_ms,device_time_ms\n";
+}
+
+MetricsWriter::MetricsWriter(MetricsFormat fmt, size_t buffer_bytes)
+    : format(fmt), file(nullptr), buffer(buffer_bytes > MAX_ROW ? buffer_bytes : MAX_ROW), used(0),
+      header_pending(false) {}
+
+MetricsWriter::~MetricsWriter() {
+    close();
+}
+
+bool MetricsWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "w");
+    header_pending = file != nullptr && format == METRICS_CSV;
+    return file != nullptr;
+}
+
+void MetricsWriter::close() {
+    if (file) {
+        flush();
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void MetricsWriter::flush() {
+    if (file && used > 0) {
+        std::fwrite(buffer.data(), 1, used, file);
+        std::fflush(file);
+    }
+    used = 0;
+}
+
+void MetricsWriter::append(const char* text, size_t length) {
+    if (used + length > buffer.size()) {
+        flush();
+        if (length > buffer.size()) {
+            if (file) {
+                std::fwrite(text, 1, length, file);
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void MetricsWriter::write(const WindowSample& sample) {
+    if (!file) {
+        return;
+    }
+    if (header_pending) {
+        append(CSV_HEADER, std::strlen(CSV_HEADER));
+        header_pending = false;
+    }
+    if (format == METRICS_JSONL) {
+        append("{\"run\":\"", 8);
+    }
+    append(label.data(), label.size());
+
+    const AdvancedStats& d = sample.delta;
+    long long accesses = d.cache_hits + d.cache_misses;
+    double hit_ratio = accesses > 0 ? static_cast<double>(d.cache_hits) / accesses : 0.0;
+    double dirty_ratio = sample.cache_blocks > 0 ? static_cast<double>(sample.dirty_blocks) / sample.cache_blocks : 0.0;
+
+    char row[MAX_ROW];
+    int length;
+    if (format == METRICS_CSV) {
+        length = std::snprintf(row, sizeof(row),
+                               ",%lld,%lld,%.3f,%d,%.6f,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%.6f,%.3f,%.3f,%.3f,%.3f\n",
+                               sample.first_op, sample.ops, sample.time, sample.warmup ? 1 : 0, hit_ratio,
+                               d.cache_hits, d.cache_misses, d.disk_reads, d.disk_writes, d.read_iops, d.write_iops,
+                               d.journal_ops, d.issued_requests, sample.dirty_blocks, dirty_ratio,
+                               sample.latency_p50, sample.latency_p99, sample.latency_p999, d.device_time);
+    } else {
+        length = std::snprintf(row, sizeof(row),
+                               "\",\"first_op\":%lld,\"ops\":%lld,\"time_ms\":%.3f,\"warmup\":%s,\"hit_ratio\":%.6f,"
+                               "\"cache_hits\":%lld,\"cache_misses\":%lld,\"disk_reads\":%lld,\"disk_writes\":%lld,"
+                               "\"read_iops\":%lld,\"write_iops\":%lld,\"journal_ops\":%lld,\"issued_requests\":%lld,"
+                               "\"dirty_blocks\":%lld,\"dirty_ratio\":%.6f,\"latency_p50_ms\":%.3f,"
+                               "\"latency_p99_ms\":%.3f,\"latency_p999_ms\":%.3f,\"device_time_ms\":%.3f}\n",
+                               sample.first_op, sample.ops, sample.time, sample.warmup ? "true" : "false", hit_ratio,
+                               d.cache_hits, d.cache_misses, d.disk_reads, d.disk_writes, d.read_iops, d.write_iops,
+                               d.journal_ops, d.issued_requests, sample.dirty_blocks, dirty_ratio,
+                               sample.latency_p50, sample.latency_p99, sample.latency_p999, d.device_time);
+    }
+    if (length > 0) {
+        append(row, static_cast<size_t>(length) < sizeof(row) ? length : sizeof(row) - 1);
+    }
+}
+
+void MetricsWriter::set_label(const std::string& l) {
+    // Se guarda ya escapada para el formato del fichero
+    label.clear();
+    if (format == METRICS_CSV) {
+        bool quote = l.find_first_of(",\"\n") != std::string::npos;
+        if (quote) {
+            label += '"';
+        }
+        for (char c : l) {
+            label += c;
+            if (c == '"') {
+                label += '"';
+            }
+        }
+        if (quote) {
+            label += '"';
+        }
+    } else {
+        for (char c : l) {
+            if (c == '"' || c == '\\') {
+                label += '\\';
+            }
+            label += c == '\n' ? ' ' : c;
+        }
+    }
+}
+
+MetricsFormat MetricsWriter::format_for(const std::string& path) {
+    auto ends_with = [&](const char* suffix) {
+        size_t n = std::strlen(suffix);
+        return path.size() >= n && path.compare(path.size() - n, n, suffix) == 0;
+    };
+    return ends_with(".jsonl") || ends_with(".json") ? METRICS_JSONL : METRICS_CSV;
+}
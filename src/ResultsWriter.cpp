@@ -0,0 +1,217 @@
+#include "ResultsWriter.hpp"
+#include <cstdio>
+#include <tabulate/table.hpp>
+
+namespace {
+
+// Un campo de AdvancedStats: exactamente uno de los dos punteros es valido.
+// Los enteros son contadores acumulados (counter en Prometheus) y los reales
+// tiempos o medias (gauge).
+struct StatField {
+    const char* name;
+    const char* help;
+    long long AdvancedStats::* integer;
+    double AdvancedStats::* real;
+};
+
+const StatField FIELDS[] = {
+    {"cache_hits", "Aciertos de cache", &AdvancedStats::cache_hits, nullptr},
+    {"cache_misses", "Fallos de cache", &AdvancedStats::cache_misses, nullptr},
+    {"disk_reads", "Bloques leidos de disco", &AdvancedStats::disk_reads, nullptr},
+    {"disk_writes", "Bloques escritos a disco", &AdvancedStats::disk_writes, nullptr},
+    {"read_iops", "Peticiones de lectura", &AdvancedStats::read_iops, nullptr},
+    {"write_iops", "Peticiones de escritura", &AdvancedStats::write_iops, nullptr},
+    {"bytes_read", "Bytes leidos", &AdvancedStats::bytes_read, nullptr},
+    {"bytes_written", "Bytes escritos", &AdvancedStats::bytes_written, nullptr},
+    {"journal_ops", "Operaciones de journal", &AdvancedStats::journal_ops, nullptr},
+    {"merged_requests", "Peticiones fusionadas en el planificador", &AdvancedStats::merged_requests, nullptr},
+    {"issued_requests", "Peticiones emitidas al dispositivo", &AdvancedStats::issued_requests, nullptr},
+    {"nand_writes", "Paginas programadas en el SSD", &AdvancedStats::nand_writes, nullptr},
+    {"block_erases", "Bloques borrados en el SSD", &AdvancedStats::block_erases, nullptr},
+    {"ghost_hits_2x", "Aciertos extra con el doble de cache", &AdvancedStats::ghost_hits_2x, nullptr},
+    {"ghost_hits_4x", "Aciertos extra con el cuadruple de cache", &AdvancedStats::ghost_hits_4x, nullptr},
+    {"total_latency", "Tiempo real de la ejecucion (ms)", nullptr, &AdvancedStats::total_latency},
+    {"avg_access_time", "Tiempo real medio por acceso (ms)", nullptr, &AdvancedStats::avg_access_time},
+    {"device_time", "Tiempo de servicio del dispositivo (ms)", nullptr, &AdvancedStats::device_time},
+    {"simulated_time", "Duracion en tiempo simulado (ms)", nullptr, &AdvancedStats::simulated_time},
+    {"op_latency", "Suma de latencias simuladas por operacion (ms)", nullptr, &AdvancedStats::op_latency},
+    {"completed_ops", "Operaciones completadas en tiempo simulado", &AdvancedStats::completed_ops, nullptr},
+    {"warmup_ops", "Operaciones descartadas por el calentamiento", &AdvancedStats::warmup_ops, nullptr},
+};
+
+std::string real_text(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", value);
+    return text;
+}
+
+std::string value_of(const StatField& field, const AdvancedStats& stats) {
+    return field.integer ? std::to_string(stats.*field.integer) : real_text(stats.*field.real);
+}
+
+// Comillas y barras escapadas; vale para JSON y para las etiquetas de Prometheus
+std::string quoted(const std::string& s) {
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            q += '\\';
+            q += c;
+        } else if (c == '\n') {
+            q += "\\n";
+        } else {
+            q += c;
+        }
+    }
+    return q + "\"";
+}
+
+std::string csv_field(const std::string& s) {
+    if (s.find_first_of(",\"\n") == std::string::npos) {
+        return s;
+    }
+    std::string q = "\"";
+    for (char c : s) {
+        q += c;
+        if (c == '"') {
+            q += '"';
+        }
+    }
+    return q + "\"";
+}
+
+}
+
+const char* journaling_name(JournalingMode mode) {
+    switch (mode) {
+        case METADATA_JOURNALING: return "metadata";
+        case FULL_JOURNALING: return "full";
+        default: return "none";
+    }
+}
+
+bool ResultsWriter::parse_format(const std::string& name, ResultsFormat& fmt) {
+    if (name == "tabla") {
+        fmt = RESULTS_TABLE;
+    } else if (name == "json") {
+        fmt = RESULTS_JSON;
+    } else if (name == "csv") {
+        fmt = RESULTS_CSV;
+    } else if (name == "prometheus") {
+        fmt = RESULTS_PROMETHEUS;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ResultsWriter::add(const RunDescription& run, const AdvancedStats& stats) {
+    switch (format) {
+        case RESULTS_JSON: write_json_row(run, stats); break;
+        case RESULTS_CSV: write_csv_row(run, stats); break;
+        default: rows.push_back({run, stats}); break;
+    }
+    written++;
+}
+
+void ResultsWriter::finish() {
+    switch (format) {
+        case RESULTS_JSON: out << (written == 0 ? "[]\n" : "\n]\n"); break;
+        case RESULTS_PROMETHEUS: write_prometheus(); break;
+        case RESULTS_TABLE: write_table(); break;
+        default: break;
+    }
+    out.flush();
+    rows.clear();
+    written = 0;
+}
+
+void ResultsWriter::write_json_row(const RunDescription& run, const AdvancedStats& stats) {
+    out << (written == 0 ? "[\n" : ",\n");
+    out << "  {\"scenario\": " << quoted(run.scenario)
+        << ", \"workload\": " << quoted(run.workload)
+        << ", \"ops\": " << run.ops
+        << ", \"write_ratio\": " << real_text(run.write_ratio)
+        << ", \"filesystem\": " << quoted(run.filesystem)
+        << ", \"journaling\": " << quoted(journaling_name(run.journaling))
+        << ", \"cache\": " << quoted(run.cache)
+        << ", \"capacity\": " << run.capacity
+        << ", \"ways\": " << run.ways
+        << ", \"block_size\": " << run.block_size
+        << ", \"scheduler\": " << quoted(run.scheduler)
+        << ", \"device\": " << quoted(run.device)
+        << ", \"tenant\": " << run.tenant
+        << ",\n   \"stats\": {";
+    bool first = true;
+    for (const StatField& field : FIELDS) {
+        out << (first ? "" : ", ") << "\"" << field.name << "\": " << value_of(field, stats);
+        first = false;
+    }
+    out << "}}";
+}
+
+void ResultsWriter::write_csv_row(const RunDescription& run, const AdvancedStats& stats) {
+    if (written == 0) {
+        out << "scenario,workload,ops,write_ratio,filesystem,journaling,cache,capacity,ways,block_size,scheduler,"
+               "device,tenant";
+        for (const StatField& field : FIELDS) {
+            out << "," << field.name;
+        }
+        out << "\n";
+    }
+    out << csv_field(run.scenario) << "," << csv_field(run.workload) << "," << run.ops << ","
+        << real_text(run.write_ratio) << "," << csv_field(run.filesystem) << "," << journaling_name(run.journaling)
+        << "," << csv_field(run.cache) << "," << run.capacity << "," << run.ways << "," << run.block_size << ","
+        << csv_field(run.scheduler) << "," << csv_field(run.device) << "," << run.tenant;
+    for (const StatField& field : FIELDS) {
+        out << "," << value_of(field, stats);
+    }
+    out << "\n";
+}
+
+void ResultsWriter::write_prometheus() {
+    // Las etiquetas de cada fila se calculan una vez y se repiten en cada metrica
+    std::vector<std::string> labels;
+    labels.reserve(rows.size());
+    for (const Row& row : rows) {
+        const RunDescription& run = row.run;
+        labels.push_back("{scenario=" + quoted(run.scenario) + ",workload=" + quoted(run.workload) +
+                         ",ops=\"" + std::to_string(run.ops) + "\",write_ratio=\"" + real_text(run.write_ratio) +
+                         "\",filesystem=" + quoted(run.filesystem) + ",journaling=\"" +
+                         journaling_name(run.journaling) + "\",cache=" + quoted(run.cache) + ",capacity=\"" +
+                         std::to_string(run.capacity) + "\",ways=\"" + std::to_string(run.ways) +
+                         "\",block_size=\"" + std::to_string(run.block_size) + "\",scheduler=" +
+                         quoted(run.scheduler) + ",device=" + quoted(run.device) + ",tenant=\"" +
+                         std::to_string(run.tenant) + "\"}");
+    }
+    for (const StatField& field : FIELDS) {
+        std::string name = std::string("fssim_") + field.name + (field.integer ? "_total" : "");
+        out << "# HELP " << name << " " << field.help << "\n";
+        out << "# TYPE " << name << " " << (field.integer ? "counter" : "gauge") << "\n";
+        for (size_t i = 0; i < rows.size(); ++i) {
+            out << name << labels[i] << " " << value_of(field, rows[i].stats) << "\n";
+        }
+    }
+}
+
+void ResultsWriter::write_table() {
+    using namespace tabulate;
+    using Row_t = Table::Row_t;
+
+    Table table;
+    table.add_row(Row_t{"Escenario", "Carga", "Sistema", "Cache", "Bloques", "Vias", "Dispositivo",
+                        "Tasa de aciertos", "Lecturas de disco", "Escrituras de disco", "Tiempo de dispositivo (ms)"});
+    for (const Row& row : rows) {
+        const RunDescription& run = row.run;
+        long long accesses = row.stats.cache_hits + row.stats.cache_misses;
+        double rate = accesses > 0 ? 100.0 * row.stats.cache_hits / accesses : 0.0;
+        table.add_row(Row_t{run.scenario, run.workload, run.filesystem, run.cache, std::to_string(run.capacity),
+                            std::to_string(run.ways), run.device.empty() ? "-" : run.device,
+                            std::to_string(rate) + " %", std::to_string(row.stats.disk_reads),
+                            std::to_string(row.stats.disk_writes), std::to_string(row.stats.device_time)});
+    }
+    table[0].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::blue)
+        .font_style({FontStyle::italic});
+    out << table << "\n";
+}
@@ -1,58 +1,298 @@
 #include "SetAssociativeCache.hpp"
+#include "Snapshot.hpp"
 
-    SetAssociativeCache::SetAssociativeCache(int size, int num_ways) : Cache(size), ways(num_ways) {
-        num_sets = capacity / ways;
-        lru_lists.resize(num_sets);
-        cache_maps.resize(num_sets);
+    SetAssociativeCache::SetAssociativeCache(int size, int num_ways, IndexHash hash)
+        : Cache(size), num_sets(size / num_ways), ways(num_ways), indexer(num_sets, hash), dirty(0), admission(nullptr) {
+        cache_entries.resize(num_sets * ways, EMPTY);
     }
 
-    SetAssociativeCache::SetAssociativeCache(SetAssociativeCache const &c) : Cache(c) , ways(c.ways){
-        num_sets = capacity / ways;
-        lru_lists = c.lru_lists;
-        cache_maps = c.cache_maps;
+    SetAssociativeCache::SetAssociativeCache(SetAssociativeCache const &c)
+        : Cache(c), num_sets(c.num_sets), ways(c.ways), indexer(c.indexer), dirty(c.dirty), admission(c.admission) {
+        cache_entries = c.cache_entries;
+        ghost_entries = c.ghost_entries;
+        owners = c.owners;
+        way_limit = c.way_limit;
+        quota = c.quota;
+        occupancy = c.occupancy;
+    }
+
+    int SetAssociativeCache::find(const uint32_t* set, uint32_t tag) const {
+        for (unsigned int w = 0; w < ways && set[w] != EMPTY; ++w) {
+            if ((set[w] >> 1) == tag) {
+                return w;
+            }
+        }
+        return -1;
     }
 
     bool SetAssociativeCache::access(int block_id, AdvancedStats& stats) {
-        int set_index = block_id % num_sets;  // Determinar el conjunto
-        auto& cache_map = cache_maps[set_index];
-        auto& lru_list = lru_lists[set_index];
-
-        auto it = cache_map.find(block_id); 
-        if (it != cache_map.end()) { // se verifica si la clave existe en el mapa
-            // Actualizar LRU dentro del conjunto para que el valor accedido sea el mas recientemente utilizado
-            lru_list.erase(it->second.lru_it);
-            lru_list.push_front(block_id);
-            it->second.lru_it = lru_list.begin();
+        if (!in_range(block_id)) {
+            stats.cache_misses++;
+            return false;
+        }
+        uint32_t set_index = indexer.index(block_id);  // Determinar el conjunto
+        uint32_t tag = indexer.tag(block_id);
+        uint32_t* set = &cache_entries[set_index * ways];
+
+        if (admission) {
+            admission->record(block_id);
+        }
+
+        int way = find(set, tag);
+        if (way >= 0) {
+            // Mover la entrada al frente para que sea la mas recientemente utilizada
+            uint32_t entry = set[way];
+            for (int w = way; w > 0; --w) {
+                set[w] = set[w - 1];
+            }
+            set[0] = entry;
+            if (!owners.empty()) {
+                uint8_t* owner = &owners[set_index * ways];
+                uint8_t o = owner[way];
+                for (int w = way; w > 0; --w) {
+                    owner[w] = owner[w - 1];
+                }
+                owner[0] = o;
+            }
             stats.cache_hits++;
             return true;
         }
         stats.cache_misses++;
+
+        if (!ghost_entries.empty()) {
+            uint32_t* ghosts = &ghost_entries[set_index * 3 * ways];
+            for (unsigned int g = 0; g < 3 * ways && ghosts[g] != EMPTY; ++g) {
+                if ((ghosts[g] >> 1) == tag) {
+                    stats.ghost_hits_4x++;
+                    if (g < ways) {
+                        stats.ghost_hits_2x++;
+                    }
+                    // Sacarlo de la lista: el bloque vuelve a la cache
+                    for (; g + 1 < 3 * ways; ++g) {
+                        ghosts[g] = ghosts[g + 1];
+                    }
+                    ghosts[3 * ways - 1] = EMPTY;
+                    break;
+                }
+            }
+        }
         return false;
     }
 
     void SetAssociativeCache::add_block(int block_id) {
-        int set_index = block_id % num_sets;
-        auto& cache_map = cache_maps[set_index];
-        auto& lru_list = lru_lists[set_index];
+        if (!in_range(block_id)) {
+            return;
+        }
+        uint32_t set_index = indexer.index(block_id);
+        uint32_t* set = &cache_entries[set_index * ways];
+
+        uint8_t* owner = owners.empty() ? nullptr : &owners[set_index * ways];
+        int victim_pos = owner ? victim_way(set, owner) : ways - 1;
 
-        if (cache_map.size() >= ways) {
-            // Eliminar el menos recientemente usado (LRU) del conjunto
-            int lru_block = lru_list.back();
-            cache_map.erase(lru_block);
-            lru_list.pop_back();
+        uint32_t victim = set[victim_pos];
+        if (admission && victim != EMPTY && !admission->admit(block_id, indexer.block(victim >> 1, set_index))) {
+            return;  // El bloque no es mas frecuente que la victima: no se admite
         }
 
-        // Insertar el nuevo bloque
-        lru_list.push_front(block_id);
-        cache_map[block_id] = {block_id, false, lru_list.begin()};
+        if (!ghost_entries.empty() && victim != EMPTY) {
+            uint32_t* ghosts = &ghost_entries[set_index * 3 * ways];
+            for (unsigned int g = 3 * ways - 1; g > 0; --g) {
+                ghosts[g] = ghosts[g - 1];
+            }
+            ghosts[0] = victim;
+        }
+
+        dirty -= victim != EMPTY && (victim & DIRTY);
+
+        // Desplazar el conjunto una posicion hasta la victima, que se descarta
+        for (int w = victim_pos; w > 0; --w) {
+            set[w] = set[w - 1];
+        }
+
+        // Insertar el nuevo bloque como el mas recientemente usado
+        set[0] = indexer.tag(block_id) << 1;
+
+        if (owner) {
+            if (tenant >= static_cast<int>(occupancy.size())) {
+                occupancy.resize(tenant + 1, 0);
+            }
+            if (victim != EMPTY) {
+                occupancy[owner[victim_pos]]--;
+            }
+            for (int w = victim_pos; w > 0; --w) {
+                owner[w] = owner[w - 1];
+            }
+            owner[0] = static_cast<uint8_t>(tenant);
+            occupancy[tenant]++;
+        }
+    }
+
+    int SetAssociativeCache::victim_way(const uint32_t* set, const uint8_t* owner) const {
+        int own = 0;
+        int own_lru = -1;
+        for (unsigned int w = 0; w < ways && set[w] != EMPTY; ++w) {
+            if (owner[w] == tenant) {
+                own++;
+                own_lru = w;
+            }
+        }
+        if (own_lru >= 0) {
+            bool over_ways = static_cast<unsigned int>(own) >= limit_of(tenant);
+            bool over_quota = tenant < static_cast<int>(quota.size()) && quota[tenant] > 0 &&
+                              occupancy[tenant] >= quota[tenant];
+            if (over_ways || over_quota) {
+                return own_lru;
+            }
+        }
+        if (set[ways - 1] == EMPTY) {
+            return ways - 1;
+        }
+
+        // El LRU de algun inquilino que se pase de su limite en este conjunto
+        for (int w = ways - 1; w >= 0; --w) {
+            unsigned int count = 0;
+            for (unsigned int v = 0; v < ways; ++v) {
+                count += owner[v] == owner[w];
+            }
+            if (count > limit_of(owner[w])) {
+                return w;
+            }
+        }
+        return ways - 1;
+    }
+
+    void SetAssociativeCache::enable_partitioning(int t) {
+        if (owners.empty()) {
+            // Lo que ya esta en la cache se atribuye al inquilino 0
+            owners.assign(num_sets * ways, 0);
+            occupancy.assign(1, 0);
+            for (uint32_t entry : cache_entries) {
+                occupancy[0] += entry != EMPTY;
+            }
+        }
+        if (t >= static_cast<int>(occupancy.size())) {
+            occupancy.resize(t + 1, 0);
+        }
+        if (t >= static_cast<int>(way_limit.size())) {
+            way_limit.resize(t + 1, 0);
+        }
+        if (t >= static_cast<int>(quota.size())) {
+            quota.resize(t + 1, 0);
+        }
+    }
+
+    bool SetAssociativeCache::set_way_partition(int t, unsigned int max_ways) {
+        if (t < 0 || t >= MAX_TENANTS) {
+            return false;
+        }
+        enable_partitioning(t);
+        way_limit[t] = max_ways;
+        return true;
+    }
+
+    bool SetAssociativeCache::set_tenant_quota(int t, long long max_blocks) {
+        if (t < 0 || t >= MAX_TENANTS) {
+            return false;
+        }
+        enable_partitioning(t);
+        quota[t] = max_blocks;
+        return true;
     }
 
     void SetAssociativeCache::mark_dirty(int block_id) {
-        int set_index = block_id % num_sets;
-        auto& cache_map = cache_maps[set_index];
+        if (!in_range(block_id)) {
+            return;
+        }
+        uint32_t set_index = indexer.index(block_id);
+        uint32_t* set = &cache_entries[set_index * ways];
+
+        int way = find(set, indexer.tag(block_id));
+        if (way >= 0) {
+            dirty += !(set[way] & DIRTY);
+            set[way] |= DIRTY;
+        }
+    }
+
+    void SetAssociativeCache::set_admission_filter(TinyLFU* filter) {
+        admission = filter;
+    }
 
-        auto it = cache_map.find(block_id);
-        if (it != cache_map.end()) {
-            it->second.dirty = true;
+    void SetAssociativeCache::enable_ghosts(bool enabled) {
+        if (enabled) {
+            ghost_entries.assign(num_sets * 3 * ways, EMPTY);
+        } else {
+            ghost_entries.clear();
+            ghost_entries.shrink_to_fit();
         }
-    }
\ No newline at end of file
+    }
+
+    void SetAssociativeCache::reset() {
+        cache_entries.assign(cache_entries.size(), EMPTY);
+        dirty = 0;
+        ghost_entries.assign(ghost_entries.size(), EMPTY);
+        owners.assign(owners.size(), 0);
+        occupancy.assign(occupancy.size(), 0);
+    }
+
+    void SetAssociativeCache::save(SnapshotWriter& out) const {
+        out.tag("SAC2");
+        out.put<uint32_t>(capacity);
+        out.put<uint32_t>(ways);
+        out.put<uint8_t>(indexer.hashing());  // Los tags y conjuntos solo valen con el mismo hash
+        out.put_vector(cache_entries);
+        out.put_vector(ghost_entries);
+        out.put_vector(owners);
+        out.put_vector(way_limit);
+        out.put_vector(quota);
+        out.put_vector(occupancy);
+    }
+
+    bool SetAssociativeCache::load(SnapshotReader& in) {
+        in.expect("SAC2");
+        in.expect_value<uint32_t>(capacity);
+        in.expect_value<uint32_t>(ways);
+        in.expect_value<uint8_t>(indexer.hashing());
+        std::vector<uint32_t> entries, ghosts;
+        std::vector<uint8_t> entry_owners;
+        std::vector<unsigned int> limits;
+        std::vector<long long> quotas, occupied;
+        in.get_vector(entries);
+        in.get_vector(ghosts);
+        in.get_vector(entry_owners);
+        in.get_vector(limits);
+        in.get_vector(quotas);
+        in.get_vector(occupied);
+        if (!in.ok() || entries.size() != cache_entries.size() ||
+            (!ghosts.empty() && ghosts.size() != cache_entries.size() * 3)) {
+            return false;
+        }
+        // Sin particionado todo el estado por inquilino esta vacio; con el, un
+        // propietario por entrada, hasta MAX_TENANTS inquilinos y limites y cuotas
+        // solo de inquilinos con ocupacion
+        if (entry_owners.empty()) {
+            if (!limits.empty() || !quotas.empty() || !occupied.empty()) {
+                return false;
+            }
+        } else {
+            if (entry_owners.size() != cache_entries.size() || occupied.empty() || occupied.size() > static_cast<size_t>(MAX_TENANTS) ||
+                limits.size() != quotas.size() || limits.size() > occupied.size()) {
+                return false;
+            }
+            for (uint8_t owner : entry_owners) {
+                if (owner >= occupied.size()) {
+                    return false;
+                }
+            }
+        }
+        cache_entries.swap(entries);
+        ghost_entries.swap(ghosts);
+        owners.swap(entry_owners);
+        way_limit.swap(limits);
+        quota.swap(quotas);
+        occupancy.swap(occupied);
+        dirty = 0;
+        for (uint32_t entry : cache_entries) {
+            dirty += entry != EMPTY && (entry & DIRTY);
+        }
+        return true;
+    }
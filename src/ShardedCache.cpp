@@ -0,0 +1,141 @@
+#include "ShardedCache.hpp"
+#include <algorithm>
+#include <chrono>
+
+// Adquiere el mutex de una franja y, si se pide, acumula el tiempo retenido
+class ShardedCache::StripeGuard {
+    Stripe& stripe;
+    bool measure;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    StripeGuard(Stripe& s, bool m) : stripe(s), measure(m) {
+        stripe.lock.lock();
+        stripe.acquisitions++;
+        if (measure) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~StripeGuard() {
+        if (measure) {
+            auto end = std::chrono::steady_clock::now();
+            stripe.hold_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        }
+        stripe.lock.unlock();
+    }
+};
+
+ShardedCache::ShardedCache(int size, int num_ways, int stripes_count, bool measure_lock_hold)
+    : Cache(std::max(size, 1)), measure_hold(measure_lock_hold) {
+    // Al menos un conjunto de una via y una franja: sin ellos set_of y la
+    // eleccion de franja dividirian por cero
+    ways = std::clamp(num_ways, 1, static_cast<int>(capacity));
+    num_sets = capacity / ways;
+    num_stripes = std::clamp(stripes_count, 1, num_sets);
+    lines.resize(num_sets * ways, {-1, false, false, 0});
+    stripes.reset(new Stripe[num_stripes]);
+}
+
+ShardedCache::ShardedCache(ShardedCache const &c)
+    : Cache(c), num_sets(c.num_sets), ways(c.ways), num_stripes(c.num_stripes),
+      measure_hold(c.measure_hold), lines(c.lines) {
+    stripes.reset(new Stripe[num_stripes]);
+    // Los relojes siguen a las marcas last_use copiadas; si no, lo usado tras
+    // la copia pareceria mas antiguo que lo copiado
+    for (int s = 0; s < num_stripes; ++s) {
+        stripes[s].clock = c.stripes[s].clock;
+    }
+}
+
+int ShardedCache::set_of(int block_id) const {
+    return static_cast<unsigned int>(block_id) % num_sets;
+}
+
+ShardedCache::CacheLine* ShardedCache::find(int set_index, int block_id) {
+    CacheLine* set = &lines[set_index * ways];
+    for (unsigned int w = 0; w < ways; ++w) {
+        if (set[w].valid && set[w].block_id == block_id) {
+            return &set[w];
+        }
+    }
+    return nullptr;
+}
+
+bool ShardedCache::access(int block_id, AdvancedStats& stats) {
+    int set_index = set_of(block_id);
+    Stripe& stripe = stripes[set_index % num_stripes];  // Conjuntos intercalados entre franjas
+    StripeGuard guard(stripe, measure_hold);
+
+    CacheLine* line = find(set_index, block_id);
+    if (line) {
+        line->last_use = ++stripe.clock;
+        stats.cache_hits++;
+        return true;
+    }
+    stats.cache_misses++;
+    return false;
+}
+
+void ShardedCache::add_block(int block_id) {
+    int set_index = set_of(block_id);
+    Stripe& stripe = stripes[set_index % num_stripes];
+    StripeGuard guard(stripe, measure_hold);
+
+    // Otro hilo pudo haber insertado el bloque entre el fallo y la insercion
+    CacheLine* line = find(set_index, block_id);
+    if (!line) {
+        // Victima: primera linea invalida o, si no hay, la menos recientemente usada
+        CacheLine* set = &lines[set_index * ways];
+        line = &set[0];
+        for (unsigned int w = 0; w < ways && line->valid; ++w) {
+            if (!set[w].valid || set[w].last_use < line->last_use) {
+                line = &set[w];
+            }
+        }
+        *line = {block_id, true, false, 0};
+    }
+    line->last_use = ++stripe.clock;
+}
+
+void ShardedCache::mark_dirty(int block_id) {
+    int set_index = set_of(block_id);
+    StripeGuard guard(stripes[set_index % num_stripes], measure_hold);
+
+    CacheLine* line = find(set_index, block_id);
+    if (line) {
+        line->dirty = true;
+    }
+}
+
+ShardedCache::LockStats ShardedCache::lock_stats() const {
+    LockStats total = {0, 0};
+    for (int i = 0; i < num_stripes; ++i) {
+        total.acquisitions += stripes[i].acquisitions;
+        total.hold_ns += stripes[i].hold_ns;
+    }
+    return total;
+}
+
+void ShardedCache::reset_lock_stats() {
+    for (int i = 0; i < num_stripes; ++i) {
+        stripes[i].acquisitions = 0;
+        stripes[i].hold_ns = 0;
+    }
+}
+
+// Sin tomar los locks: solo es exacto si no hay accesos concurrentes
+long long ShardedCache::dirty_blocks() const {
+    long long dirty = 0;
+    for (const CacheLine& line : lines) {
+        dirty += line.valid && line.dirty;
+    }
+    return dirty;
+}
+
+void ShardedCache::reset() {
+    lines.assign(lines.size(), {-1, false, false, 0});
+    for (int i = 0; i < num_stripes; ++i) {
+        stripes[i].clock = 0;
+    }
+}
@@ -1,64 +1,183 @@
 #include "Simulator.hpp"
 #include <iostream>
 #include <iomanip>
-#include <random>
-#include <chrono>
 #include <tabulate/table.hpp>
 #include <string>
+#include <algorithm>
 
 void initialize_stat(AdvancedStats& stats) {
     stats.cache_hits = 0;
     stats.cache_misses = 0;
     stats.disk_reads = 0;
     stats.disk_writes = 0;
+    stats.read_iops = 0;
+    stats.write_iops = 0;
+    stats.bytes_read = 0;
+    stats.bytes_written = 0;
     stats.journal_ops = 0;
+    stats.merged_requests = 0;
+    stats.issued_requests = 0;
+    stats.nand_writes = 0;
+    stats.block_erases = 0;
+    stats.ghost_hits_2x = 0;
+    stats.ghost_hits_4x = 0;
     stats.total_latency = 0;
     stats.avg_access_time = 0.0;
+    stats.device_time = 0.0;
+    stats.simulated_time = 0.0;
+    stats.op_latency = 0.0;
+    stats.completed_ops = 0;
+    stats.warmup_ops = 0;
 }
 
-std::vector<int> generate_access_pattern(int num_ops, bool sequential) {
-    std::vector<int> addresses;
-    //std::random_device rd;
-    //std::mt19937 gen(rd());
-    std::mt19937 gen(10);
-    
-    if (sequential) {
-        for (int i = 0; i < num_ops; ++i) {
-            addresses.push_back(i * 4096);  // Bloques de 4K
-        }
-    } else {
-        std::uniform_int_distribution<> dist(0, 1 << 24);
-        for (int i = 0; i < num_ops; ++i) {
-            addresses.push_back(dist(gen));
+void accumulate_delta(AdvancedStats& into, const AdvancedStats& before, const AdvancedStats& after) {
+    into.cache_hits += after.cache_hits - before.cache_hits;
+    into.cache_misses += after.cache_misses - before.cache_misses;
+    into.disk_reads += after.disk_reads - before.disk_reads;
+    into.disk_writes += after.disk_writes - before.disk_writes;
+    into.read_iops += after.read_iops - before.read_iops;
+    into.write_iops += after.write_iops - before.write_iops;
+    into.bytes_read += after.bytes_read - before.bytes_read;
+    into.bytes_written += after.bytes_written - before.bytes_written;
+    into.journal_ops += after.journal_ops - before.journal_ops;
+    into.merged_requests += after.merged_requests - before.merged_requests;
+    into.issued_requests += after.issued_requests - before.issued_requests;
+    into.nand_writes += after.nand_writes - before.nand_writes;
+    into.block_erases += after.block_erases - before.block_erases;
+    into.ghost_hits_2x += after.ghost_hits_2x - before.ghost_hits_2x;
+    into.ghost_hits_4x += after.ghost_hits_4x - before.ghost_hits_4x;
+    into.device_time += after.device_time - before.device_time;
+    into.op_latency += after.op_latency - before.op_latency;
+    into.completed_ops += after.completed_ops - before.completed_ops;
+}
+
+RunMonitor::RunMonitor(const RunConfig& cfg, const FileSystem& filesystem)
+    : config(cfg), fs(filesystem), window_first_op(0), window_start_time(0.0), boundary(0),
+      warming(cfg.warmup.mode != NO_WARMUP), device_before_reset(0.0), time(0.0) {
+    initialize_stat(window_start);
+    if (config.warmup.mode == WARMUP_STEADY_STATE && config.window_ops <= 0 && config.window_ms <= 0.0) {
+        config.window_ops = 1000;  // La deteccion necesita ventanas
+    }
+    if (config.warmup.windows < 2) {
+        config.warmup.windows = 2;
+    }
+    boundary = config.window_ops > 0 ? config.window_ops : -1;
+    if (warming && config.warmup.mode == WARMUP_OPS) {
+        if (config.warmup.ops <= 0) {
+            warming = false;
+        } else if (boundary < 0 || config.warmup.ops < boundary) {
+            boundary = config.warmup.ops;
         }
     }
-    return addresses;
 }
 
-// Función de simulación
-void run_simulation(FileSystem& fs, std::vector<int>& addresses, AdvancedStats& stats) {
+void RunMonitor::close_window(long long ops, AdvancedStats& stats) {
+    if (ops == window_first_op) {
+        return;
+    }
+    if (config.series) {
+        WindowSample sample;
+        sample.first_op = window_first_op;
+        sample.ops = ops - window_first_op;
+        sample.time = time;
+        sample.warmup = warming;
+        sample.dirty_blocks = fs.dirty_blocks();
+        sample.cache_blocks = fs.cache_size();
+        sample.latency_p50 = latency.percentile(0.50);
+        sample.latency_p99 = latency.percentile(0.99);
+        sample.latency_p999 = latency.percentile(0.999);
+        initialize_stat(sample.delta);
+        accumulate_delta(sample.delta, window_start, stats);
+        config.series->add(sample);
+        latency.clear();
+    }
+    if (warming && config.warmup.mode == WARMUP_STEADY_STATE) {
+        long long hits = stats.cache_hits - window_start.cache_hits;
+        long long total = hits + stats.cache_misses - window_start.cache_misses;
+        recent.push_back(total > 0 ? static_cast<double>(hits) / total : 0.0);
+        if (static_cast<int>(recent.size()) > config.warmup.windows) {
+            recent.erase(recent.begin());
+        }
+    }
+    window_start = stats;
+    window_first_op = ops;
+    window_start_time = time;
+}
 
+void RunMonitor::end_warmup(long long ops, AdvancedStats& stats) {
+    warming = false;
+    device_before_reset += stats.device_time;
     initialize_stat(stats);
+    stats.warmup_ops = ops;
+    window_start = stats;
+    if (config.tenants) {
+        config.tenants->clear();
+    }
+}
 
-    //std::random_device rd;
-    //std::mt19937 gen(rd());
-    std::mt19937 gen(12345);
-    std::uniform_int_distribution<> dist(0, 9); // Generar números entre 0 y 9
-
-    auto start = std::chrono::high_resolution_clock::now();
+long long RunMonitor::advance(long long ops, double arrival, AdvancedStats& stats) {
+    time = std::max(arrival, device_before_reset + stats.device_time);
 
-    for (int addr : addresses) {
-        int operation = dist(gen); // Generar operación aleatoria
-        if (operation < 2) {  // 20% escrituras
-            fs.write(addr, stats);
-        } else {
-            fs.read(addr, stats);
+    if (warming && config.warmup.mode == WARMUP_TIME && time >= config.warmup.ms) {
+        close_window(ops, stats);
+        end_warmup(ops, stats);
+    } else if (warming && config.warmup.mode == WARMUP_OPS && ops >= config.warmup.ops) {
+        close_window(ops, stats);
+        end_warmup(ops, stats);
+    } else if ((config.window_ops > 0 && ops - window_first_op >= config.window_ops) ||
+               (config.window_ms > 0.0 && time - window_start_time >= config.window_ms)) {
+        close_window(ops, stats);
+        if (warming && config.warmup.mode == WARMUP_STEADY_STATE) {
+            bool converged = static_cast<int>(recent.size()) == config.warmup.windows &&
+                             *std::max_element(recent.begin(), recent.end()) -
+                             *std::min_element(recent.begin(), recent.end()) <= config.warmup.tolerance;
+            if (converged || (config.warmup.max_ops > 0 && ops >= config.warmup.max_ops)) {
+                end_warmup(ops, stats);
+            }
         }
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    stats.total_latency = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    stats.avg_access_time = stats.total_latency / addresses.size();
+    boundary = config.window_ops > 0 ? window_first_op + config.window_ops : -1;
+    if (warming && config.warmup.mode == WARMUP_OPS && (boundary < 0 || config.warmup.ops < boundary)) {
+        boundary = config.warmup.ops;
+    }
+    return boundary;
+}
+
+void RunMonitor::finish(long long ops, AdvancedStats& stats) {
+    time = std::max(time, device_before_reset + stats.device_time);
+    if (warming) {
+        // Todo fue calentamiento: no se mezclan los fallos en frio con lo medido
+        close_window(ops, stats);
+        end_warmup(ops, stats);
+    } else if (config.window_ops > 0 || config.window_ms > 0.0) {
+        close_window(ops, stats);
+    }
+    if (config.series) {
+        config.series->flush();
+    }
+}
+
+std::vector<int> generate_access_pattern(int num_ops, bool sequential) {
+    std::vector<int> addresses;
+    addresses.reserve(num_ops);
+    for (int address : AccessPattern(num_ops, sequential)) {
+        addresses.push_back(address);
+    }
+    return addresses;
+}
+
+std::string hit_rate(const AdvancedStats& stats) {
+    long long total = stats.cache_hits + stats.cache_misses;
+    return std::to_string(total > 0 ? 100.0 * stats.cache_hits / total : 0.0) + " %";
+}
+
+// Paginas programadas por pagina escrita por el anfitrion; "-" si no hay flash
+std::string write_amplification(const AdvancedStats& stats) {
+    if (stats.nand_writes == 0 || stats.disk_writes == 0) {
+        return "-";
+    }
+    return std::to_string(static_cast<double>(stats.nand_writes) / stats.disk_writes);
 }
 
 void print_stats(const AdvancedStats& stats, const std::string& fs_name, COLOR c) {
@@ -71,15 +190,22 @@ void print_stats(const AdvancedStats& stats, const std::string& fs_name, COLOR c
     std::cout << "Fallos de caché: " << stats.cache_misses << "\n";
     std::cout << "Lecturas de disco: " << stats.disk_reads << "\n";
     std::cout << "Escrituras de disco: " << stats.disk_writes << "\n";
+    std::cout << "Peticiones de lectura: " << stats.read_iops << " (" << stats.bytes_read << " bytes)\n";
+    std::cout << "Peticiones de escritura: " << stats.write_iops << " (" << stats.bytes_written << " bytes)\n";
+    std::cout << "Peticiones fusionadas: " << stats.merged_requests << "\n";
+    std::cout << "Peticiones emitidas al disco: " << stats.issued_requests << "\n";
+    std::cout << "Amplificacion de escritura: " << write_amplification(stats) << " (" << stats.block_erases << " borrados)\n";
     //std::cout << "Operaciones de journal: " << stats.journal_ops << "\n";
     std::cout << std::fixed << std::setprecision(8);
     std::cout << "Latencia total: " << stats.total_latency << " ms\n";
-    std::cout << "Tiempo medio por acceso: " << stats.avg_access_time << " ms\n\n";
+    std::cout << "Tiempo medio por acceso: " << stats.avg_access_time << " ms\n";
+    std::cout << "Tiempo de dispositivo: " << stats.device_time << " ms\n\n";
 
     std::cout << "\033[0m";
 }
 
-tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const AdvancedStats& stats_ext4, std::string& name) {
+tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const AdvancedStats& stats_ext4, std::string& name,
+                                  const AdvancedStats* opt_ext3, const AdvancedStats* opt_ext4) {
 	using namespace tabulate;
 	using Row_t = Table::Row_t;
 	
@@ -103,9 +229,24 @@ tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const Advance
 	stats.add_row(Row_t{"Fallos de cache", std::to_string(stats_ext3.cache_misses), std::to_string(stats_ext4.cache_misses)});
 	stats.add_row(Row_t{"Lecturas de disco", std::to_string(stats_ext3.disk_reads), std::to_string(stats_ext4.disk_reads)});
 	stats.add_row(Row_t{"Escrituras de disco", std::to_string(stats_ext3.disk_writes), std::to_string(stats_ext4.disk_writes)});
+	stats.add_row(Row_t{"Peticiones de lectura", std::to_string(stats_ext3.read_iops), std::to_string(stats_ext4.read_iops)});
+	stats.add_row(Row_t{"Peticiones de escritura", std::to_string(stats_ext3.write_iops), std::to_string(stats_ext4.write_iops)});
+	stats.add_row(Row_t{"Bytes leidos", std::to_string(stats_ext3.bytes_read), std::to_string(stats_ext4.bytes_read)});
+	stats.add_row(Row_t{"Bytes escritos", std::to_string(stats_ext3.bytes_written), std::to_string(stats_ext4.bytes_written)});
+	stats.add_row(Row_t{"Peticiones fusionadas", std::to_string(stats_ext3.merged_requests), std::to_string(stats_ext4.merged_requests)});
+	stats.add_row(Row_t{"Peticiones emitidas al disco", std::to_string(stats_ext3.issued_requests), std::to_string(stats_ext4.issued_requests)});
 	//stats.add_row(Row_t{"Operaciones de journal", std::to_string(stats_ext3.journal_ops), std::to_string(stats_ext4.journal_ops)});
+	stats.add_row(Row_t{"Tiempo de dispositivo (ms)", std::to_string(stats_ext3.device_time), std::to_string(stats_ext4.device_time)});
+	stats.add_row(Row_t{"Amplificacion de escritura", write_amplification(stats_ext3), write_amplification(stats_ext4)});
+	stats.add_row(Row_t{"Borrados de bloque", std::to_string(stats_ext3.block_erases), std::to_string(stats_ext4.block_erases)});
 	stats.add_row(Row_t{"Latencia Total", std::to_string(stats_ext3.total_latency), std::to_string(stats_ext4.total_latency)});
 	stats.add_row(Row_t{"Tiempo medio por acceso", std::to_string(stats_ext3.avg_access_time), std::to_string(stats_ext4.avg_access_time)});
+	stats.add_row(Row_t{"Aciertos extra con 2x cache", std::to_string(stats_ext3.ghost_hits_2x), std::to_string(stats_ext4.ghost_hits_2x)});
+	stats.add_row(Row_t{"Aciertos extra con 4x cache", std::to_string(stats_ext3.ghost_hits_4x), std::to_string(stats_ext4.ghost_hits_4x)});
+	if (opt_ext3 && opt_ext4) {
+		stats.add_row(Row_t{"Tasa de aciertos", hit_rate(stats_ext3), hit_rate(stats_ext4)});
+		stats.add_row(Row_t{"Techo optimo (Belady)", hit_rate(*opt_ext3), hit_rate(*opt_ext4)});
+	}
 	
     
     main.add_row(Row_t{stats});
@@ -115,3 +256,77 @@ tabulate::Table print_stats_table(const AdvancedStats& stats_ext3, const Advance
 	//std::cout << main << "\n\n";
 }
 
+
+tabulate::Table print_tenant_table(const TenantStats& tenants, std::string& name) {
+	using namespace tabulate;
+	using Row_t = Table::Row_t;
+
+	Table main;
+	main.format()
+    .border_color(Color::yellow)
+    .hide_border();
+
+    main.add_row(Row_t{name});
+
+    main[0].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::blue)
+        .font_style({FontStyle::underline, FontStyle::italic});
+
+    // Una columna por inquilino
+    auto row = [&](const std::string& label, auto value) {
+        Row_t r{label};
+        for (int t = 0; t < tenants.tenants(); ++t) {
+            r.push_back(value(t));
+        }
+        return r;
+    };
+
+    Table stats;
+	stats.add_row(row("Inquilino", [](int t) { return std::to_string(t); }));
+	stats.add_row(row("Aciertos de cache", [&](int t) { return std::to_string(tenants.of(t).cache_hits); }));
+	stats.add_row(row("Fallos de cache", [&](int t) { return std::to_string(tenants.of(t).cache_misses); }));
+	stats.add_row(row("Tasa de aciertos", [&](int t) { return hit_rate(tenants.of(t)); }));
+	stats.add_row(row("Lecturas de disco", [&](int t) { return std::to_string(tenants.of(t).disk_reads); }));
+	stats.add_row(row("Escrituras de disco", [&](int t) { return std::to_string(tenants.of(t).disk_writes); }));
+	stats.add_row(row("Latencia media (ms)", [&](int t) { return std::to_string(tenants.latency_of(t).mean()); }));
+	stats.add_row(row("Latencia p50 (ms)", [&](int t) { return std::to_string(tenants.latency_of(t).percentile(0.50)); }));
+	stats.add_row(row("Latencia p99 (ms)", [&](int t) { return std::to_string(tenants.latency_of(t).percentile(0.99)); }));
+	stats.add_row(row("Latencia p99.9 (ms)", [&](int t) { return std::to_string(tenants.latency_of(t).percentile(0.999)); }));
+
+    main.add_row(Row_t{stats});
+    stats.format().border_color(Color::green);
+
+    return main;
+}
+
+tabulate::Table print_time_series_table(const TimeSeries& series, std::string& name) {
+	using namespace tabulate;
+	using Row_t = Table::Row_t;
+
+	Table main;
+	main.format()
+    .border_color(Color::yellow)
+    .hide_border();
+
+    main.add_row(Row_t{name});
+
+    main[0].format()
+        .font_align(FontAlign::center)
+        .font_color(Color::blue)
+        .font_style({FontStyle::underline, FontStyle::italic});
+
+    Table stats;
+	stats.add_row(Row_t{"Operaciones", "Tiempo (ms)", "Tasa de aciertos", "Lecturas de disco", "Escrituras de disco", "Fase"});
+    for (size_t i = 0; i < series.size(); ++i) {
+        const WindowSample& w = series[i];
+        std::string ops = std::to_string(w.first_op) + "-" + std::to_string(w.first_op + w.ops);
+        stats.add_row(Row_t{ops, std::to_string(w.time), hit_rate(w.delta), std::to_string(w.delta.disk_reads),
+                            std::to_string(w.delta.disk_writes), w.warmup ? "calentamiento" : "medida"});
+    }
+
+    main.add_row(Row_t{stats});
+    stats.format().border_color(Color::green);
+
+    return main;
+}
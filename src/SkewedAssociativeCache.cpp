@@ -0,0 +1,99 @@
+#include "SkewedAssociativeCache.hpp"
+#include "SetIndex.hpp"
+#include "Snapshot.hpp"
+
+SkewedAssociativeCache::SkewedAssociativeCache(int size, int num_ways)
+    : Cache(size), num_sets(size / num_ways), ways(num_ways), clock(0) {
+    lines.resize(num_sets * ways, {EMPTY, 0});
+}
+
+SkewedAssociativeCache::SkewedAssociativeCache(SkewedAssociativeCache const &c)
+    : Cache(c), num_sets(c.num_sets), ways(c.ways), clock(c.clock), lines(c.lines) {}
+
+SkewedAssociativeCache::CacheLine& SkewedAssociativeCache::line(int block_id, unsigned int way) {
+    return lines[way * num_sets + skew_index(block_id, way, num_sets)];
+}
+
+SkewedAssociativeCache::CacheLine* SkewedAssociativeCache::find(int block_id) {
+    if (!in_range(block_id)) {
+        return nullptr;
+    }
+    uint32_t tag = static_cast<uint32_t>(block_id);
+    for (unsigned int w = 0; w < ways; ++w) {
+        CacheLine& l = line(block_id, w);
+        if (l.entry != EMPTY && (l.entry >> 1) == tag) {
+            return &l;
+        }
+    }
+    return nullptr;
+}
+
+bool SkewedAssociativeCache::access(int block_id, AdvancedStats& stats) {
+    CacheLine* l = find(block_id);
+    if (l) {
+        l->last_use = ++clock;
+        stats.cache_hits++;
+        return true;
+    }
+    stats.cache_misses++;
+    return false;
+}
+
+void SkewedAssociativeCache::add_block(int block_id) {
+    if (!in_range(block_id)) {
+        return;
+    }
+    // Victima: la linea mas antigua entre las posiciones del bloque en cada via
+    CacheLine* victim = &line(block_id, 0);
+    for (unsigned int w = 1; w < ways; ++w) {
+        CacheLine& l = line(block_id, w);
+        if (age(l) > age(*victim)) {
+            victim = &l;
+        }
+    }
+    *victim = {static_cast<uint32_t>(block_id) << 1, ++clock};
+}
+
+void SkewedAssociativeCache::mark_dirty(int block_id) {
+    CacheLine* l = find(block_id);
+    if (l) {
+        l->entry |= DIRTY;
+    }
+}
+
+void SkewedAssociativeCache::reset() {
+    lines.assign(lines.size(), {EMPTY, 0});
+    clock = 0;
+}
+
+long long SkewedAssociativeCache::dirty_blocks() const {
+    long long dirty = 0;
+    for (const CacheLine& l : lines) {
+        dirty += l.entry != EMPTY && (l.entry & DIRTY);
+    }
+    return dirty;
+}
+
+void SkewedAssociativeCache::save(SnapshotWriter& out) const {
+    out.tag("SKC1");
+    out.put<uint32_t>(capacity);
+    out.put<uint32_t>(ways);
+    out.put<uint32_t>(clock);
+    out.put_vector(lines);
+}
+
+bool SkewedAssociativeCache::load(SnapshotReader& in) {
+    in.expect("SKC1");
+    in.expect_value<uint32_t>(capacity);
+    in.expect_value<uint32_t>(ways);
+    uint32_t saved_clock = 0;
+    std::vector<CacheLine> saved;
+    in.get(saved_clock);
+    in.get_vector(saved);
+    if (!in.ok() || saved.size() != lines.size()) {
+        return false;
+    }
+    clock = saved_clock;
+    lines.swap(saved);
+    return true;
+}
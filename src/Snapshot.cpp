@@ -0,0 +1,81 @@
+#include "Snapshot.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[8] = {'F', 'S', 'S', 'N', 'A', 'P', 0, 1};
+
+}
+
+SnapshotWriter::SnapshotWriter() : buffer(MAGIC, MAGIC + sizeof(MAGIC)) {}
+
+void SnapshotWriter::pad() {
+    buffer.resize((buffer.size() + 7) & ~static_cast<size_t>(7), 0);
+}
+
+bool SnapshotWriter::write_file(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    bool written = std::fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size();
+    return std::fclose(f) == 0 && written;
+}
+
+SnapshotReader::SnapshotReader(const std::string& path) : data(nullptr), length(0), offset(0), valid(false) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= static_cast<off_t>(sizeof(MAGIC))) {
+        void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const char*>(mapped);
+            length = st.st_size;
+            // La restauracion lee el fichero de principio a fin
+            madvise(mapped, length, MADV_SEQUENTIAL);
+            valid = std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+            offset = sizeof(MAGIC);
+        }
+    }
+    close(fd);
+}
+
+SnapshotReader::~SnapshotReader() {
+    if (data) {
+        munmap(const_cast<char*>(data), length);
+    }
+}
+
+void SnapshotReader::pad() {
+    offset = (offset + 7) & ~static_cast<size_t>(7);
+    if (offset > length) {
+        valid = false;
+        offset = length;
+    }
+}
+
+bool SnapshotReader::take(void* out, size_t n) {
+    if (!valid || n > length - offset) {
+        valid = false;
+        return false;
+    }
+    if (n > 0) {  // Un vector vacio tiene data() == nullptr
+        std::memcpy(out, data + offset, n);
+    }
+    offset += n;
+    return true;
+}
+
+bool SnapshotReader::expect(const char (&name)[5]) {
+    uint32_t stored = 0;
+    if (get(stored) && stored != SnapshotWriter::code(name)) {
+        valid = false;
+    }
+    return valid;
+}
@@ -0,0 +1,158 @@
+#include "SolidStateDrive.hpp"
+#include <algorithm>
+#include <cassert>
+
+SolidStateDrive::SolidStateDrive(const SSDGeometry& geo) : geometry(geo), next_die(0), collecting(false) {
+    // La recoleccion puede necesitar abrir un bloque antes de liberar la victima
+    geometry.gc_threshold = std::max(geometry.gc_threshold, 2);
+    num_dies = geometry.channels * geometry.dies_per_channel;
+    uint32_t physical_pages = static_cast<uint32_t>(num_dies) * geometry.blocks_per_die * geometry.pages_per_block;
+    logical_pages = static_cast<uint32_t>(physical_pages * (1.0 - geometry.overprovisioning));
+    // Los bloques libres de reserva y el activo de cada die no cuentan como espacio util
+    uint32_t reserved = static_cast<uint32_t>(num_dies) * (geometry.gc_threshold + 1) * geometry.pages_per_block;
+    logical_pages = std::min(logical_pages, physical_pages - std::min(physical_pages, reserved));
+
+    l2p.assign(logical_pages, UNMAPPED);
+    p2l.assign(physical_pages, UNMAPPED);
+    valid_pages.assign(num_dies * geometry.blocks_per_die, 0);
+    state.assign(num_dies * geometry.blocks_per_die, FREE);
+    channel_busy.assign(geometry.channels, 0.0);
+
+    dies.resize(num_dies);
+    for (int d = 0; d < num_dies; ++d) {
+        Die& die = dies[d];
+        for (int b = geometry.blocks_per_die - 1; b > 0; --b) {
+            die.free_blocks.push_back(b);
+        }
+        die.active_block = 0;
+        die.write_pointer = 0;
+        die.busy_until = 0.0;
+        state[global_block(d, 0)] = ACTIVE;
+    }
+}
+
+uint32_t SolidStateDrive::allocate_page(int d, AdvancedStats& stats) {
+    Die& die = dies[d];
+    if (die.write_pointer == geometry.pages_per_block) {
+        // Las escrituras solo llegan a un die con hueco y la recoleccion
+        // comprueba que sus copias quepan
+        assert(!die.free_blocks.empty() && "die sin bloques libres");
+        state[global_block(d, die.active_block)] = FULL;
+        die.active_block = die.free_blocks.back();
+        die.free_blocks.pop_back();
+        die.write_pointer = 0;
+        state[global_block(d, die.active_block)] = ACTIVE;
+    }
+    uint32_t ppn = static_cast<uint32_t>(global_block(d, die.active_block)) * geometry.pages_per_block + die.write_pointer++;
+
+    if (!collecting && static_cast<int>(die.free_blocks.size()) < geometry.gc_threshold) {
+        collect(d, stats);
+    }
+    return ppn;
+}
+
+void SolidStateDrive::collect(int d, AdvancedStats& stats) {
+    collecting = true;
+    Die& die = dies[d];
+    while (static_cast<int>(die.free_blocks.size()) < geometry.gc_threshold) {
+        // Victima voraz: el bloque lleno con menos paginas validas
+        int victim = -1;
+        for (int b = 0; b < geometry.blocks_per_die; ++b) {
+            int g = global_block(d, b);
+            if (state[g] == FULL && (victim < 0 || valid_pages[g] < valid_pages[global_block(d, victim)])) {
+                victim = b;
+            }
+        }
+        if (victim < 0 || valid_pages[global_block(d, victim)] == geometry.pages_per_block) {
+            break;  // Nada que recuperar
+        }
+        if (die.free_blocks.empty() && valid_pages[global_block(d, victim)] > geometry.pages_per_block - die.write_pointer) {
+            break;  // Las copias no caben en el bloque activo
+        }
+
+        int g = global_block(d, victim);
+        uint32_t first = static_cast<uint32_t>(g) * geometry.pages_per_block;
+        for (uint32_t ppn = first; ppn < first + geometry.pages_per_block; ++ppn) {
+            uint32_t lpn = p2l[ppn];
+            if (lpn == UNMAPPED || l2p[lpn] != ppn) {
+                continue;
+            }
+            // Copia interna del die: lectura + programacion, sin pasar por el canal
+            uint32_t target = allocate_page(d, stats);
+            l2p[lpn] = target;
+            p2l[target] = lpn;
+            p2l[ppn] = UNMAPPED;
+            valid_pages[g]--;
+            valid_pages[target / geometry.pages_per_block]++;
+            die.busy_until += geometry.read_ms + geometry.program_ms;
+            stats.nand_writes++;
+        }
+
+        die.busy_until += geometry.erase_ms;
+        stats.block_erases++;
+        state[g] = FREE;
+        die.free_blocks.push_back(victim);
+    }
+    collecting = false;
+}
+
+double SolidStateDrive::write_page(uint32_t lpn, double now, AdvancedStats& stats) {
+    // Un die sin hueco recolecta (puede tener paginas invalidadas desde la
+    // ultima recoleccion) y, si sigue sin hueco, cede el turno al siguiente
+    int d = next_die;
+    for (int tries = 0; tries < num_dies; ++tries, d = (d + 1) % num_dies) {
+        if (!has_room(d)) {
+            collect(d, stats);
+        }
+        if (has_room(d)) {
+            break;
+        }
+    }
+    assert(has_room(d) && "ningun die tiene hueco");
+    next_die = (d + 1) % num_dies;
+    Die& die = dies[d];
+    double& channel = channel_busy[d % geometry.channels];
+
+    uint32_t old = l2p[lpn];
+    if (old != UNMAPPED) {
+        p2l[old] = UNMAPPED;
+        valid_pages[old / geometry.pages_per_block]--;
+    }
+
+    // Datos por el canal y despues programacion en el die
+    double start = std::max(now, channel);
+    channel = start + geometry.transfer_ms;
+    double program_start = std::max(channel, die.busy_until);
+    die.busy_until = program_start + geometry.program_ms;
+    double done = die.busy_until;
+
+    uint32_t ppn = allocate_page(d, stats);
+    l2p[lpn] = ppn;
+    p2l[ppn] = lpn;
+    valid_pages[ppn / geometry.pages_per_block]++;
+    stats.nand_writes++;
+    return done;
+}
+
+double SolidStateDrive::read_page(uint32_t lpn, double now) {
+    uint32_t ppn = l2p[lpn];
+    int d = ppn != UNMAPPED ? die_of(ppn) : static_cast<int>(lpn % num_dies);
+    Die& die = dies[d];
+    double& channel = channel_busy[d % geometry.channels];
+
+    double start = std::max(now, die.busy_until);
+    die.busy_until = start + geometry.read_ms;
+    double transfer_start = std::max(die.busy_until, channel);
+    channel = transfer_start + geometry.transfer_ms;
+    return channel;
+}
+
+double SolidStateDrive::service(const DiskRequest& request, double now, AdvancedStats& stats) {
+    double done = now;
+    for (int i = 0; i < request.num_blocks; ++i) {
+        uint32_t lpn = static_cast<uint32_t>(request.first_block + i) % logical_pages;
+        double page_done = request.write ? write_page(lpn, now, stats) : read_page(lpn, now);
+        done = std::max(done, page_done);
+    }
+    return done;
+}
@@ -0,0 +1,93 @@
+#include "TenantStats.hpp"
+#include "Simulator.hpp"
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKETS, 0), total(0), sum_ms(0.0), max_ms(0.0) {}
+
+int LatencyHistogram::bucket_of(uint64_t us) {
+    if (us < 2 * SUB_BUCKETS) {
+        return static_cast<int>(us);
+    }
+    // Exponente tal que us >> shift cae en [SUB_BUCKETS, 2 * SUB_BUCKETS)
+    int shift = 63 - __builtin_clzll(us) - 5;
+    int bucket = shift * SUB_BUCKETS + static_cast<int>(us >> shift);
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+double LatencyHistogram::lower_bound_ms(int bucket) {
+    if (bucket < 2 * SUB_BUCKETS) {
+        return bucket / 1000.0;
+    }
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint64_t mantissa = bucket - shift * SUB_BUCKETS;
+    return static_cast<double>(mantissa << shift) / 1000.0;
+}
+
+void LatencyHistogram::record(double ms) {
+    uint64_t us = ms > 0.0 ? static_cast<uint64_t>(ms * 1000.0) : 0;
+    counts[bucket_of(us)]++;
+    total++;
+    sum_ms += ms;
+    if (ms > max_ms) {
+        max_ms = ms;
+    }
+}
+
+double LatencyHistogram::percentile(double p) const {
+    if (total == 0) {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(p * total);
+    rank = rank < total ? rank : total - 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen > rank) {
+            // La ultima cubeta no tiene limite superior
+            return b + 1 < BUCKETS ? std::min(lower_bound_ms(b + 1), max_ms) : max_ms;
+        }
+    }
+    return max_ms;
+}
+
+void LatencyHistogram::clear() {
+    counts.assign(BUCKETS, 0);
+    total = 0;
+    sum_ms = 0.0;
+    max_ms = 0.0;
+}
+
+void TenantStats::ensure(int tenant) {
+    while (static_cast<int>(per_tenant.size()) <= tenant) {
+        AdvancedStats empty;
+        initialize_stat(empty);
+        per_tenant.push_back(empty);
+        latency.emplace_back();
+    }
+}
+
+bool TenantStats::add(int tenant, const AdvancedStats& before, const AdvancedStats& after) {
+    if (tenant < 0 || tenant >= MAX_TENANTS) {
+        return false;
+    }
+    ensure(tenant);
+    accumulate_delta(per_tenant[tenant], before, after);
+    return true;
+}
+
+bool TenantStats::record_latency(int tenant, double ms) {
+    if (tenant < 0 || tenant >= MAX_TENANTS) {
+        return false;
+    }
+    ensure(tenant);
+    AdvancedStats& s = per_tenant[tenant];
+    s.op_latency += ms;
+    s.completed_ops++;
+    latency[tenant].record(ms);
+    return true;
+}
+
+void TenantStats::clear() {
+    per_tenant.clear();
+    latency.clear();
+}
@@ -0,0 +1,31 @@
+#include "TimeSeries.hpp"
+#include "MetricsWriter.hpp"
+
+TimeSeries::TimeSeries(size_t capacity)
+    : ring(capacity > 0 ? capacity : 1), head(0), count(0), total(0), writer(nullptr) {}
+
+void TimeSeries::add(const WindowSample& sample) {
+    if (writer) {
+        writer->write(sample);
+    }
+    if (count < ring.size()) {
+        ring[(head + count) % ring.size()] = sample;
+        count++;
+    } else {
+        ring[head] = sample;
+        head = (head + 1) % ring.size();
+    }
+    total++;
+}
+
+void TimeSeries::flush() {
+    if (writer) {
+        writer->flush();
+    }
+}
+
+void TimeSeries::clear() {
+    head = 0;
+    count = 0;
+    total = 0;
+}
@@ -0,0 +1,214 @@
+#include "TimedSimulation.hpp"
+
+TimedSimulation::TimedSimulation(FileSystem& f, BlockDevice& dev, const TimingConfig& cfg)
+    : fs(f), device(dev), config(cfg), mix(cfg.write_ratio), previous_sink(nullptr),
+      journal_committed(0), op_done(0.0), in_flight(0), tenants(nullptr), scheduler(nullptr), current(0),
+      wakeup_pending(false) {
+    config.clients = std::max(config.clients, 1);
+    config.queue_depth = std::max(config.queue_depth, 1);
+    op_start.assign(slots(), 0.0);
+    slot_tenant.assign(slots(), 0);
+    events.reserve(slots() + 2);
+}
+
+void TimedSimulation::begin_run(AdvancedStats& stats) {
+    initialize_stat(stats);
+    events.clear();
+    dirty.clear();
+    journal_committed = 0;
+    in_flight = 0;
+    queued.clear();
+    wakeup_pending = false;
+    if (tenants) {
+        tenants->clear();
+    }
+
+    previous_sink = fs.io_scheduler();
+    fs.set_io_scheduler(this);
+    if (config.journal_commit_ms > 0) {
+        events.push(config.journal_commit_ms, JOURNAL_COMMIT, 0);
+    }
+    if (config.writeback_ms > 0) {
+        events.push(config.writeback_ms, WRITEBACK, 0);
+    }
+}
+
+void TimedSimulation::end_run(AdvancedStats& stats) {
+    commit_journal(stats);
+    write_back(stats);
+    if (scheduler) {
+        // Las ultimas escrituras se atienden tras el final de los sucesos
+        DiskRequest request;
+        while (scheduler->take(request)) {
+            device.dispatch(request, events.now(), stats);
+        }
+    }
+    fs.set_io_scheduler(previous_sink);
+
+    stats.simulated_time = std::max(events.now(), device.now());
+    stats.avg_access_time = stats.completed_ops > 0 ? stats.op_latency / stats.completed_ops : 0.0;
+}
+
+void TimedSimulation::begin_op(uint32_t waiter) {
+    op_done = events.now() + config.hit_latency_ms;
+    current = waiter;
+    if (scheduler) {
+        if (waiter >= waiters.size()) {
+            waiters.resize(waiter + 1);
+        }
+        waiters[waiter] = {0.0, 0, false, DONE};
+    }
+}
+
+void TimedSimulation::end_op(uint32_t slot, AdvancedStats& stats) {
+    op_start[slot] = events.now();
+    finish_op(DONE, slot, stats);
+}
+
+void TimedSimulation::finish_op(uint32_t type, uint32_t data, AdvancedStats& stats) {
+    if (!scheduler) {
+        events.push(op_done, type, data);
+        return;
+    }
+    Waiter& w = waiters[data];
+    w.done = std::max(w.done, op_done);
+    w.type = type;
+    if (w.pending == 0) {
+        events.push(w.done, type, data);
+    } else {
+        w.finished = true;
+    }
+    kick(stats);
+}
+
+void TimedSimulation::kick(AdvancedStats& stats) {
+    // Mientras el dispositivo este libre, la siguiente segun la politica
+    double now = events.now();
+    DiskRequest request;
+    while (device.start_time(now) <= now && scheduler->take(request, &merged)) {
+        resolve(device.dispatch(request, now, stats));
+    }
+    if (scheduler->pending() > 0 && !wakeup_pending) {
+        wakeup_pending = true;
+        events.push(device.start_time(now), DEVICE_FREE, 0);
+    }
+}
+
+void TimedSimulation::resolve(double done) {
+    // Solo las peticiones fusionadas en la despachada: las de escritura
+    // diferida y journal no estan en queued
+    for (long long id : merged) {
+        auto it = std::lower_bound(queued.begin(), queued.end(), id,
+                                   [](const QueuedRequest& q, long long key) { return q.id < key; });
+        if (it == queued.end() || it->id != id) {
+            continue;
+        }
+        Waiter& w = waiters[it->waiter];
+        w.done = std::max(w.done, done);
+        if (--w.pending == 0 && w.finished) {
+            events.push(w.done, w.type, it->waiter);
+        }
+        queued.erase(it);
+    }
+}
+
+void TimedSimulation::send(const DiskRequest& request, AdvancedStats& stats) {
+    if (scheduler) {
+        scheduler->enqueue(request, stats);
+    } else {
+        device.dispatch(request, events.now(), stats);
+    }
+}
+
+void TimedSimulation::complete_op(uint32_t slot, AdvancedStats& stats) {
+    double latency = events.now() - op_start[slot];
+    stats.op_latency += latency;
+    stats.completed_ops++;
+    if (tenants) {
+        tenants->record_latency(slot_tenant[slot], latency);
+    }
+    in_flight--;
+}
+
+void TimedSimulation::submit(const DiskRequest& request, AdvancedStats& stats) {
+    if (request.write && config.writeback_ms > 0) {
+        // Escritura diferida: la operacion no espera al disco
+        if (!dirty.empty()) {
+            DiskRequest& tail = dirty.back();
+            if (tail.first_block + tail.num_blocks == request.first_block &&
+                tail.num_blocks + request.num_blocks <= config.max_request_blocks) {
+                tail.num_blocks += request.num_blocks;
+                stats.merged_requests++;
+                return;
+            }
+        }
+        dirty.push_back(request);
+        return;
+    }
+    if (scheduler) {
+        queued.push_back({scheduler->enqueue(request, stats), current});
+        waiters[current].pending++;
+        return;
+    }
+    op_done = std::max(op_done, device.dispatch(request, events.now(), stats));
+}
+
+void TimedSimulation::periodic(const Event& ev, AdvancedStats& stats) {
+    if (ev.type == DEVICE_FREE) {
+        wakeup_pending = false;
+        kick(stats);
+        return;
+    }
+    double period = 0.0;
+    if (ev.type == JOURNAL_COMMIT) {
+        commit_journal(stats);
+        period = config.journal_commit_ms;
+    } else {
+        write_back(stats);
+        period = config.writeback_ms;
+    }
+    if (scheduler) {
+        kick(stats);
+    }
+    // Sin operaciones en vuelo la cola se vacia y la simulacion termina
+    if (in_flight > 0) {
+        events.push(events.now() + period, ev.type, 0);
+    }
+}
+
+void TimedSimulation::commit_journal(AdvancedStats& stats) {
+    // Los registros del journal se escriben de forma secuencial desde el bloque 0
+    long long pending = stats.journal_ops - journal_committed;
+    journal_committed = stats.journal_ops;
+    int offset = 0;
+    while (pending > 0) {
+        int n = static_cast<int>(std::min<long long>(pending, config.max_request_blocks));
+        send({offset, n, true, 0}, stats);
+        offset += n;
+        pending -= n;
+    }
+}
+
+void TimedSimulation::write_back(AdvancedStats& stats) {
+    if (dirty.empty()) {
+        return;
+    }
+    // Orden por bloque y fusion de tramos adyacentes antes de emitir
+    std::sort(dirty.begin(), dirty.end(), [](const DiskRequest& a, const DiskRequest& b) {
+        return a.first_block < b.first_block;
+    });
+    DiskRequest run = dirty[0];
+    for (size_t i = 1; i < dirty.size(); ++i) {
+        const DiskRequest& r = dirty[i];
+        if (r.first_block <= run.first_block + run.num_blocks &&
+            r.first_block + r.num_blocks - run.first_block <= config.max_request_blocks) {
+            run.num_blocks = std::max(run.num_blocks, r.first_block + r.num_blocks - run.first_block);
+            stats.merged_requests++;
+        } else {
+            send(run, stats);
+            run = r;
+        }
+    }
+    send(run, stats);
+    dirty.clear();
+}
@@ -0,0 +1,58 @@
+#include "TinyLFU.hpp"
+#include <algorithm>
+
+TinyLFU::TinyLFU(int capacity) : additions(0), sample_size(10 * capacity) {
+    uint32_t words = 1;
+    while (words < static_cast<uint32_t>(capacity)) {
+        words <<= 1;
+    }
+    table.resize(words, 0);
+    word_mask = words - 1;
+
+    uint32_t door_words = words / 8 > 0 ? words / 8 : 1;  // 8 bits por bloque
+    doorkeeper.resize(door_words, 0);
+    door_mask = door_words * 64 - 1;
+}
+
+void TinyLFU::door_add(uint64_t h) {
+    uint32_t a = h & door_mask;
+    uint32_t b = (h >> 32) & door_mask;
+    doorkeeper[a >> 6] |= 1ull << (a & 63);
+    doorkeeper[b >> 6] |= 1ull << (b & 63);
+}
+
+void TinyLFU::record(int block_id) {
+    uint64_t h = hash(block_id);
+
+    if (!door_contains(h)) {
+        // Primera aparicion desde el ultimo envejecimiento: solo el doorkeeper
+        door_add(h);
+    } else {
+        uint64_t& word = table[(h >> 8) & word_mask];
+        for (unsigned int row = 0; row < 4; ++row) {
+            unsigned int shift = nibble(h, row) << 2;
+            if (((word >> shift) & 0xf) < 15) {
+                word += 1ull << shift;
+            }
+        }
+    }
+
+    if (++additions >= sample_size) {
+        age();
+    }
+}
+
+void TinyLFU::age() {
+    // Dividir los 16 contadores de cada palabra a la vez
+    for (uint64_t& word : table) {
+        word = (word >> 1) & 0x7777777777777777ull;
+    }
+    std::fill(doorkeeper.begin(), doorkeeper.end(), 0);
+    additions /= 2;
+}
+
+void TinyLFU::reset() {
+    std::fill(table.begin(), table.end(), 0);
+    std::fill(doorkeeper.begin(), doorkeeper.end(), 0);
+    additions = 0;
+}
@@ -0,0 +1,190 @@
+#include "Workload.hpp"
+#include <climits>
+#include <cmath>
+
+ZipfGenerator::ZipfGenerator(int n, double t) : items(n), theta(t), harmonic(std::abs(1.0 - t) < 1e-9) {
+    zetan = 0;
+    for (int i = 1; i <= items; ++i) {
+        zetan += 1.0 / std::pow(i, theta);
+    }
+    double zeta2 = 1.0 + 1.0 / std::pow(2.0, theta);
+    if (harmonic) {
+        // Cuando theta -> 1, (1 - eta (1-u))^alpha -> exp(-ln(n/2) (1-u) / (1 - zeta2/zetan))
+        alpha = 0.0;
+        eta = std::log(items / 2.0) / (1.0 - zeta2 / zetan);
+    } else {
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - std::pow(2.0 / items, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+    }
+}
+
+int ZipfGenerator::next(double u) const {
+    double uz = u * zetan;
+    if (uz < 1.0) {
+        return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta)) {
+        return 1;
+    }
+    double scale = harmonic ? std::exp(-eta * (1.0 - u)) : std::pow(eta * u - eta + 1.0, alpha);
+    int rank = static_cast<int>(items * scale);
+    return rank < items ? rank : items - 1;
+}
+
+Workload::Workload(int bs, uint64_t s) : block_size(bs), seed(s) {
+    rewind();
+}
+
+bool Workload::add_phase(const PhaseSpec& p) {
+    if (p.keys.empty()) {
+        return false;
+    }
+    for (const KeySpec& k : p.keys) {
+        if (k.num_blocks < 1 || k.tenant < 0 || k.tenant >= MAX_TENANTS) {
+            return false;
+        }
+    }
+    phases.push_back(p);
+    if (phases.size() == 1) {
+        rewind();
+    }
+    return true;
+}
+
+void Workload::rewind() {
+    gen.seed(seed);
+    phase = 0;
+    clock = 0;
+    burst_end = 0;
+    latest = 0;
+    start_phase();
+}
+
+long long Workload::total_ops() const {
+    long long total = 0;
+    for (const PhaseSpec& p : phases) {
+        total += p.ops;
+    }
+    return total;
+}
+
+void Workload::start_phase() {
+    phase_op = 0;
+    components.clear();
+    total_weight = 0;
+    if (phase >= phases.size()) {
+        return;
+    }
+    for (const KeySpec& k : phases[phase].keys) {
+        bool zipf = k.distribution == ZIPF || k.distribution == SCRAMBLED_ZIPF || k.distribution == LATEST;
+        components.push_back({k, zipf ? ZipfGenerator(k.num_blocks, k.zipf_theta) : ZipfGenerator(), 0});
+        total_weight += k.weight;
+    }
+}
+
+int Workload::next_block(Component& c, bool write) {
+    const KeySpec& k = c.spec;
+    int n = k.num_blocks;
+    // Deriva del conjunto caliente: todas las distribuciones se desplazan igual
+    long long drift = k.drift_every > 0 ? (phase_op / k.drift_every) * k.drift_step : 0;
+    long long block = 0;
+
+    switch (k.distribution) {
+        case UNIFORM:
+            block = static_cast<long long>(gen.uniform() * n);
+            break;
+        case ZIPF:
+            block = c.zipf.next(gen.uniform());
+            break;
+        case SCRAMBLED_ZIPF: {
+            // FNV-1a del rango para dispersar los bloques populares
+            uint64_t h = 0xcbf29ce484222325ull;
+            uint64_t rank = c.zipf.next(gen.uniform());
+            for (int i = 0; i < 8; ++i) {
+                h = (h ^ ((rank >> (i * 8)) & 0xff)) * 0x100000001b3ull;
+            }
+            block = h % n;
+            break;
+        }
+        case HOTSPOT: {
+            long long hot = static_cast<long long>(k.hot_fraction * n);
+            hot = hot > 0 ? hot : 1;
+            if (gen.uniform() < k.hot_probability || hot >= n) {
+                block = static_cast<long long>(gen.uniform() * hot);
+            } else {
+                block = hot + static_cast<long long>(gen.uniform() * (n - hot));
+            }
+            break;
+        }
+        case LATEST:
+            if (write) {
+                latest = (latest + 1) % n;
+                block = latest;
+            } else {
+                block = latest - c.zipf.next(gen.uniform());
+            }
+            break;
+        case SEQUENTIAL:
+            block = c.position;
+            c.position += k.stride;
+            break;
+    }
+    block = (block + drift) % n;
+    return static_cast<int>(block < 0 ? block + n : block);
+}
+
+double Workload::next_arrival(const PhaseSpec& p) {
+    switch (p.arrivals) {
+        case CLOSED_LOOP:
+            break;
+        case POISSON:
+            clock += -std::log(1.0 - gen.uniform()) / p.rate;
+            break;
+        case ON_OFF:
+            clock += -std::log(1.0 - gen.uniform()) / p.rate;
+            if (clock > burst_end) {
+                // Fin de la rafaga: periodo de silencio y nueva rafaga
+                clock = burst_end - std::log(1.0 - gen.uniform()) * p.off_ms;
+                burst_end = clock - std::log(1.0 - gen.uniform()) * p.on_ms;
+            }
+            break;
+    }
+    return clock;
+}
+
+bool Workload::next(AccessRecord& record) {
+    while (phase < phases.size() && phase_op >= phases[phase].ops) {
+        phase++;
+        start_phase();
+    }
+    if (phase >= phases.size()) {
+        return false;
+    }
+    const PhaseSpec& p = phases[phase];
+
+    Component* c = &components[0];
+    if (components.size() > 1) {
+        double pick = gen.uniform() * total_weight;
+        for (Component& candidate : components) {
+            c = &candidate;
+            pick -= candidate.spec.weight;
+            if (pick < 0) {
+                break;
+            }
+        }
+    }
+
+    record.write = gen.uniform() < p.write_ratio;
+    // En 64 bits: el desplazamiento se pliega para que quepa en un int
+    long long addressable = INT_MAX / block_size;
+    long long block = (static_cast<long long>(c->spec.first_block) + next_block(*c, record.write)) % addressable;
+    record.address = static_cast<int>((block < 0 ? block + addressable : block) * block_size);
+    record.tenant = c->spec.tenant;
+    record.size = p.max_size > p.min_size
+        ? p.min_size + static_cast<int>(gen.uniform() * (p.max_size - p.min_size + 1))
+        : (p.min_size > 0 ? p.min_size : block_size);
+    record.size = record.size > 0 ? record.size : 1;
+    record.arrival = next_arrival(p);
+    phase_op++;
+    return true;
+}
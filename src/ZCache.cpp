@@ -0,0 +1,65 @@
+#include "ZCache.hpp"
+#include "SetIndex.hpp"
+#include <cstddef>
+
+ZCache::ZCache(int size, int num_ways, int walk_levels)
+    : SkewedAssociativeCache(size, num_ways), levels(walk_levels) {}
+
+ZCache::ZCache(ZCache const &c) : SkewedAssociativeCache(c), levels(c.levels) {}
+
+bool ZCache::on_path(int candidate, uint32_t pos) const {
+    for (int i = candidate; i >= 0; i = candidates[i].parent) {
+        if (candidates[i].pos == pos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ZCache::add_block(int block_id) {
+    if (!in_range(block_id)) {
+        return;
+    }
+    candidates.clear();
+    for (unsigned int w = 0; w < ways; ++w) {
+        candidates.push_back({w * num_sets + skew_index(block_id, w, num_sets), w, -1});
+    }
+
+    // Expandir el arbol de reubicaciones nivel por nivel
+    size_t level_start = 0;
+    for (int level = 1; level < levels; ++level) {
+        size_t level_end = candidates.size();
+        for (size_t i = level_start; i < level_end; ++i) {
+            const CacheLine& l = lines[candidates[i].pos];
+            if (l.entry == EMPTY) {
+                continue;  // Una linea vacia ya es la mejor victima posible
+            }
+            int moved = l.entry >> 1;
+            for (unsigned int w = 0; w < ways; ++w) {
+                if (w == candidates[i].way) {
+                    continue;
+                }
+                uint32_t pos = w * num_sets + skew_index(moved, w, num_sets);
+                if (!on_path(i, pos)) {
+                    candidates.push_back({pos, w, static_cast<int>(i)});
+                }
+            }
+        }
+        level_start = level_end;
+    }
+
+    size_t victim = 0;
+    for (size_t i = 1; i < candidates.size(); ++i) {
+        if (age(lines[candidates[i].pos]) > age(lines[candidates[victim].pos])) {
+            victim = i;
+        }
+    }
+
+    // Desplazar cada bloque del camino a la linea de su hijo y colocar el nuevo en la raiz
+    int i = static_cast<int>(victim);
+    while (candidates[i].parent >= 0) {
+        lines[candidates[i].pos] = lines[candidates[candidates[i].parent].pos];
+        i = candidates[i].parent;
+    }
+    lines[candidates[i].pos] = {static_cast<uint32_t>(block_id) << 1, ++clock};
+}